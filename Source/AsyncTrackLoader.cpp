@@ -0,0 +1,92 @@
+/*
+  ==============================================================================
+
+    AsyncTrackLoader.cpp
+    Created: 17 Oct 2026 2:48:20pm
+
+  ==============================================================================
+*/
+
+#include "AsyncTrackLoader.h"
+
+AsyncTrackLoader::AsyncTrackLoader(PlayerAudio& d)
+    : juce::Thread("Track loader"), deck(d)
+{
+    // created here, on the message thread, so the worker only ever copies it
+    selfReference = this;
+    startThread();
+}
+
+AsyncTrackLoader::~AsyncTrackLoader()
+{
+    cancelPending();
+    stopThread(4000);
+}
+
+void AsyncTrackLoader::loadAsync(const juce::File& file, Callback onLoaded)
+{
+    {
+        const juce::ScopedLock sl(lock);
+        requestedFile = file;
+        requestedCallback = std::move(onLoaded);
+        requestedAt = juce::Time::getMillisecondCounterHiRes();
+        hasRequest = true;
+        ++generation;
+    }
+
+    notify();
+}
+
+void AsyncTrackLoader::cancelPending()
+{
+    const juce::ScopedLock sl(lock);
+    hasRequest = false;
+    requestedCallback = nullptr;
+    ++generation;
+}
+
+void AsyncTrackLoader::run()
+{
+    while (!threadShouldExit())
+    {
+        juce::File file;
+        Callback callback;
+        double startedAt = 0.0;
+        juce::uint32 requestGeneration = 0;
+
+        {
+            const juce::ScopedLock sl(lock);
+            if (hasRequest)
+            {
+                file = requestedFile;
+                callback = std::move(requestedCallback);
+                startedAt = requestedAt;
+                requestGeneration = generation.load();
+                hasRequest = false;
+            }
+        }
+
+        if (callback == nullptr)
+        {
+            wait(-1);
+            continue;
+        }
+
+        auto track = deck.prepareTrack(file);
+
+        // a newer request arrived while this one was opening
+        if (requestGeneration != generation.load())
+            continue;
+
+        auto shared = std::make_shared<std::unique_ptr<PreparedTrack>>(std::move(track));
+        auto weakThis = selfReference;
+
+        juce::MessageManager::callAsync([weakThis, shared, callback, startedAt, requestGeneration]
+            {
+                if (weakThis == nullptr || weakThis->generation.load() != requestGeneration)
+                    return;
+
+                callback(std::move(*shared), juce::Time::getMillisecondCounterHiRes() - startedAt);
+            });
+    }
+}
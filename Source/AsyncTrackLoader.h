@@ -0,0 +1,44 @@
+/*
+  ==============================================================================
+
+    AsyncTrackLoader.h
+    Created: 17 Oct 2026 2:48:20pm
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "PlayerAudio.h"
+
+// Opens tracks for one deck on a worker thread. Only the newest request counts:
+// a request that is superseded while queued is dropped, and one that is
+// superseded while opening is discarded instead of being delivered.
+class AsyncTrackLoader : private juce::Thread
+{
+public:
+    // Called on the message thread; track is nullptr if the file could not be opened.
+    // totalMilliseconds runs from the loadAsync() call to delivery.
+    using Callback = std::function<void(std::unique_ptr<PreparedTrack> track, double totalMilliseconds)>;
+
+    explicit AsyncTrackLoader(PlayerAudio& deck);
+    ~AsyncTrackLoader() override;
+
+    void loadAsync(const juce::File& file, Callback onLoaded);
+    void cancelPending();
+
+private:
+    void run() override;
+
+    PlayerAudio& deck;
+    juce::CriticalSection lock;
+    juce::File requestedFile;
+    Callback requestedCallback;
+    double requestedAt = 0.0;
+    bool hasRequest = false;
+    std::atomic<juce::uint32> generation{ 0 };
+    juce::WeakReference<AsyncTrackLoader> selfReference;
+
+    JUCE_DECLARE_WEAK_REFERENCEABLE(AsyncTrackLoader)
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AsyncTrackLoader)
+};
@@ -0,0 +1,28 @@
+/*
+  ==============================================================================
+
+    AtomicFile.cpp
+    Created: 18 Oct 2026 9:12:37am
+
+  ==============================================================================
+*/
+
+#include "AtomicFile.h"
+
+bool writeFileAtomically(const juce::File& file, const juce::MemoryBlock& data)
+{
+    return writeFileAtomically(file, [&data](const juce::File& temp)
+        {
+            return temp.replaceWithData(data.getData(), data.getDataSize());
+        });
+}
+
+bool writeFileAtomically(const juce::File& file, const std::function<bool(const juce::File&)>& write)
+{
+    if (!file.getParentDirectory().createDirectory())
+        return false;
+
+    // deleted on the way out unless it has replaced the target
+    juce::TemporaryFile temp(file);
+    return write(temp.getFile()) && temp.overwriteTargetFileWithTemporary();
+}
@@ -0,0 +1,19 @@
+/*
+  ==============================================================================
+
+    AtomicFile.h
+    Created: 18 Oct 2026 9:12:37am
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// Writes the file next to its target and moves it over the target only once complete,
+// so a crash or a failed write leaves either the old file or the new one, never half of
+// either. Both create the parent folder first and return false if any step fails.
+bool writeFileAtomically(const juce::File& file, const juce::MemoryBlock& data);
+// For output too big to build in memory: write fills the temporary file it is given and
+// returns false to abandon it, leaving the target untouched
+bool writeFileAtomically(const juce::File& file, const std::function<bool(const juce::File&)>& write);
@@ -0,0 +1,111 @@
+/*
+  ==============================================================================
+
+    AudioEngine.cpp
+    Created: 18 Oct 2026 3:41:26am
+
+  ==============================================================================
+*/
+
+#include "AudioEngine.h"
+
+AudioEngine::~AudioEngine()
+{
+    closeAudioDevice();
+    mixer.releaseResources();
+
+    for (auto* deck : decks)
+        mixer.removeDeck(*deck);
+}
+
+PlayerAudio* AudioEngine::addDeck()
+{
+    auto deck = std::make_unique<PlayerAudio>();
+    if (!mixer.addDeck(*deck))
+        return nullptr;
+
+    return decks.add(std::move(deck));
+}
+
+void AudioEngine::removeLastDeck()
+{
+    if (decks.isEmpty())
+        return;
+
+    mixer.removeDeck(*decks.getLast());
+    decks.removeLast();
+}
+
+juce::String AudioEngine::openAudioDevice()
+{
+    if (deviceOpen)
+        return {};
+
+    auto error = deviceManager.initialiseWithDefaultDevices(0, 2);
+    if (error.isNotEmpty())
+        return error;
+
+    auto* device = deviceManager.getCurrentAudioDevice();
+    if (device == nullptr)
+        return "No audio output device available";
+
+    // one buffer queued ahead of the device, plus whatever the device adds
+    mixer.setOutputLatency((device->getOutputLatencyInSamples() + device->getCurrentBufferSizeSamples())
+                           / device->getCurrentSampleRate());
+    sourcePlayer.setSource(&mixer);
+    deviceManager.addAudioCallback(&sourcePlayer);
+    deviceOpen = true;
+    return {};
+}
+
+void AudioEngine::closeAudioDevice()
+{
+    if (!deviceOpen)
+        return;
+
+    deviceManager.removeAudioCallback(&sourcePlayer);
+    sourcePlayer.setSource(nullptr);
+    deviceManager.closeAudioDevice();
+    deviceOpen = false;
+}
+
+double AudioEngine::getDeviceSampleRate()
+{
+    auto* device = deviceManager.getCurrentAudioDevice();
+    return device != nullptr ? device->getCurrentSampleRate() : 0.0;
+}
+
+void AudioEngine::prepareOffline(double sampleRate, int blockSize)
+{
+    // the device and an offline render would both drive the decks
+    jassert(!deviceOpen);
+
+    offlineSampleRate = sampleRate;
+    offlineBlock.setSize(2, juce::jmax(1, blockSize));
+    renderedSamples = 0;
+    mixer.prepareToPlay(offlineBlock.getNumSamples(), sampleRate);
+}
+
+bool AudioEngine::renderOffline(juce::int64 numSamples, juce::AudioFormatWriter* writer)
+{
+    jassert(offlineSampleRate > 0.0);
+
+    while (numSamples > 0)
+    {
+        const int blockSamples = (int)juce::jmin((juce::int64)offlineBlock.getNumSamples(), numSamples);
+        mixer.getNextAudioBlock(juce::AudioSourceChannelInfo(&offlineBlock, 0, blockSamples));
+
+        if (writer != nullptr && !writer->writeFromAudioSampleBuffer(offlineBlock, 0, blockSamples))
+            return false;
+
+        numSamples -= blockSamples;
+        renderedSamples += blockSamples;
+    }
+
+    return true;
+}
+
+bool AudioEngine::isAnyDeckPlaying() const
+{
+    return std::any_of(decks.begin(), decks.end(), [](PlayerAudio* deck) { return deck->isPlaying(); });
+}
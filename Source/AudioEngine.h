@@ -0,0 +1,62 @@
+/*
+  ==============================================================================
+
+    AudioEngine.h
+    Created: 18 Oct 2026 3:41:26am
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "PlayerAudio.h"
+#include "DeckMixer.h"
+
+// The player without its GUI: a set of decks summed by a DeckMixer, rendered
+// either in real time to an audio device or offline, block by block, to a
+// file or to nowhere at all. Needs only the audio and event modules, so it
+// runs on machines with no display. Whichever thread drives an offline render
+// plays the part of the audio thread; everything else is message-thread only.
+class AudioEngine
+{
+public:
+    AudioEngine() = default;
+    ~AudioEngine();
+
+    // nullptr once the mixer is full
+    PlayerAudio* addDeck();
+    void removeLastDeck();
+    int getNumDecks() const { return decks.size(); }
+    PlayerAudio& getDeck(int index) { return *decks[index]; }
+    DeckMixer& getMixer() { return mixer; }
+
+    // Real-time output on the default device; returns an error or an empty string
+    juce::String openAudioDevice();
+    void closeAudioDevice();
+    bool isDeviceOpen() const { return deviceOpen; }
+    double getDeviceSampleRate();
+    juce::AudioDeviceManager& getDeviceManager() { return deviceManager; }
+
+    // Offline output, as fast as the CPU allows. A null writer renders into nothing,
+    // which is how the engine is profiled without any output device.
+    void prepareOffline(double sampleRate, int blockSize);
+    bool renderOffline(juce::int64 numSamples, juce::AudioFormatWriter* writer);
+    juce::int64 getRenderedSamples() const { return renderedSamples; }
+    double getOfflineSampleRate() const { return offlineSampleRate; }
+
+    bool isAnyDeckPlaying() const;
+
+private:
+    juce::OwnedArray<PlayerAudio> decks;  // declared before the mixer, so they outlive it
+    DeckMixer mixer;
+
+    juce::AudioDeviceManager deviceManager;
+    juce::AudioSourcePlayer sourcePlayer;
+    bool deviceOpen = false;
+
+    juce::AudioBuffer<float> offlineBlock;
+    double offlineSampleRate = 0.0;
+    juce::int64 renderedSamples = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AudioEngine)
+};
@@ -0,0 +1,870 @@
+/*
+  ==============================================================================
+
+    Benchmarks.cpp
+    Created: 17 Oct 2026 12:15:03pm
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "PlayerAudio.h"
+#include "VarispeedSource.h"
+#include "GainPanStage.h"
+#include "DeckMixer.h"
+#include "PlayerGUI.h"
+#include "PlaylistModel.h"
+#include <iostream>
+
+namespace
+{
+    struct TimingSummary
+    {
+        double meanMicros = 0.0;
+        double p50Micros = 0.0;
+        double p99Micros = 0.0;
+    };
+
+    TimingSummary summarise(juce::Array<double>& micros)
+    {
+        TimingSummary result;
+        if (micros.isEmpty())
+            return result;
+
+        micros.sort();
+        double total = 0.0;
+        for (auto m : micros)
+            total += m;
+
+        result.meanMicros = total / micros.size();
+        result.p50Micros = micros[micros.size() / 2];
+        result.p99Micros = micros[juce::jmin(micros.size() - 1, (int)(micros.size() * 0.99))];
+        return result;
+    }
+
+    double ticksToMicros(juce::int64 ticks)
+    {
+        return juce::Time::highResolutionTicksToSeconds(ticks) * 1.0e6;
+    }
+
+    // Everything left after removing the best-fit sine at the known frequency
+    // (radians per sample), relative to that sine, in dB
+    double measureThdPlusNoise(const float* signal, int numSamples, double omega)
+    {
+        double ss = 0.0, cc = 0.0, sc = 0.0, ys = 0.0, yc = 0.0;
+        for (int n = 0; n < numSamples; ++n)
+        {
+            const double s = std::sin(omega * n), c = std::cos(omega * n);
+            ss += s * s; cc += c * c; sc += s * c;
+            ys += signal[n] * s; yc += signal[n] * c;
+        }
+
+        // least-squares amplitude of the sine and cosine parts
+        const double det = ss * cc - sc * sc;
+        const double a = (ys * cc - yc * sc) / det;
+        const double b = (yc * ss - ys * sc) / det;
+
+        double fundamental = 0.0, residual = 0.0;
+        for (int n = 0; n < numSamples; ++n)
+        {
+            const double fit = a * std::sin(omega * n) + b * std::cos(omega * n);
+            fundamental += fit * fit;
+            residual += (signal[n] - fit) * (signal[n] - fit);
+        }
+
+        return 10.0 * std::log10(juce::jmax(residual, 1.0e-30) / fundamental);
+    }
+
+    constexpr int mixerBlockSize = 512;
+    constexpr double mixerSampleRate = 44100.0;
+
+    // Mixer callback time with numDecks decks on the fixture; false if it would not load
+    bool measureMixerCallback(const juce::File& fixture, int numDecks, bool halfStopped, int renderThreads,
+        TimingSummary& result)
+    {
+        const int numBlocks = 2000;
+
+        // decks outlive the mixer, which releases them on destruction
+        std::vector<std::unique_ptr<PlayerAudio>> decks;
+        DeckMixer mixer;
+        mixer.setRenderThreads(renderThreads);
+        mixer.prepareToPlay(mixerBlockSize, mixerSampleRate);
+
+        for (int i = 0; i < numDecks; ++i)
+        {
+            decks.push_back(std::make_unique<PlayerAudio>());
+            auto& deck = *decks.back();
+            deck.setReadAheadEnabled(false);
+            deck.setDecodedCacheEnabled(false);
+            mixer.addDeck(deck);
+
+            if (!deck.LoadFile(fixture))
+                return false;
+
+            deck.setPosition(i * 7.0);
+            if (!halfStopped || i % 2 == 0)
+                deck.play();
+        }
+
+        juce::AudioBuffer<float> buffer(2, mixerBlockSize);
+        juce::AudioSourceChannelInfo info(&buffer, 0, mixerBlockSize);
+        for (int i = 0; i < 10; ++i)
+            mixer.getNextAudioBlock(info);
+
+        juce::Array<double> micros;
+        for (int i = 0; i < numBlocks; ++i)
+        {
+            auto start = juce::Time::getHighResolutionTicks();
+            mixer.getNextAudioBlock(info);
+            micros.add(ticksToMicros(juce::Time::getHighResolutionTicks() - start));
+        }
+
+        mixer.releaseResources();
+        result = summarise(micros);
+        return true;
+    }
+
+    juce::String formatCallbackTiming(const TimingSummary& summary)
+    {
+        const double budgetMicros = mixerBlockSize / mixerSampleRate * 1.0e6;
+        return "mean " + juce::String(summary.meanMicros, 1) + " us, p99 " + juce::String(summary.p99Micros, 1)
+            + " us (" + juce::String(100.0 * summary.meanMicros / budgetMicros, 1) + "% of budget)";
+    }
+}
+
+juce::File createBenchmarkFixture(const juce::File& directory, double seconds, double sampleRate, const juce::String& format)
+{
+    auto file = directory.getChildFile("bench_fixture_" + juce::String((int)seconds) + "s." + format);
+    if (file.existsAsFile())
+        return file;
+
+    const int numChannels = 2;
+    const int blockSize = 4096;
+    auto totalSamples = (juce::int64)(seconds * sampleRate);
+
+    std::unique_ptr<juce::AudioFormat> audioFormat;
+    if (format == "flac")
+        audioFormat = std::make_unique<juce::FlacAudioFormat>();
+    else
+        audioFormat = std::make_unique<juce::WavAudioFormat>();
+
+    std::unique_ptr<juce::AudioFormatWriter> writer(audioFormat->createWriterFor(new juce::FileOutputStream(file),
+        sampleRate, numChannels, 16, {}, 0));
+    if (writer == nullptr)
+        return {};
+
+    juce::AudioBuffer<float> block(numChannels, blockSize);
+    juce::Random random(1234);
+    double phase = 0.0;
+
+    for (juce::int64 written = 0; written < totalSamples; written += blockSize)
+    {
+        int n = (int)juce::jmin((juce::int64)blockSize, totalSamples - written);
+        for (int i = 0; i < n; ++i)
+        {
+            // a sweep plus a little noise so no codec or page cache can shortcut it
+            float s = 0.4f * (float)std::sin(phase) + 0.05f * (random.nextFloat() - 0.5f);
+            phase += juce::MathConstants<double>::twoPi * (220.0 + 0.01 * (double)(written + i)) / sampleRate;
+            block.setSample(0, i, s);
+            block.setSample(1, i, -s);
+        }
+        writer->writeFromAudioSampleBuffer(block, 0, n);
+    }
+
+    return file;
+}
+
+juce::String runSeekLatencyBenchmark(const juce::File& fixture)
+{
+    const int numSeeks = 2000;
+    const int blockSize = 512;
+    juce::String report;
+
+    for (bool mapped : { false, true })
+    {
+        PlayerAudio deck;
+        deck.setReadAheadEnabled(false);
+        deck.setDecodedCacheEnabled(false);
+        deck.setMemoryMappingEnabled(mapped);
+        deck.prepareToPlay(blockSize, 44100.0);
+
+        if (!deck.LoadFile(fixture))
+            return "seek latency: could not load " + fixture.getFullPathName() + "\n";
+
+        deck.play();
+
+        juce::AudioBuffer<float> buffer(2, blockSize);
+        juce::AudioSourceChannelInfo info(&buffer, 0, blockSize);
+        juce::Random random(42);
+        juce::Array<double> micros;
+        double length = deck.getLength();
+
+        for (int i = 0; i < numSeeks; ++i)
+        {
+            double target = random.nextDouble() * length * 0.95;
+            auto start = juce::Time::getHighResolutionTicks();
+            deck.setPosition(target);
+            deck.getNextAudioBlock(info);
+            micros.add(ticksToMicros(juce::Time::getHighResolutionTicks() - start));
+        }
+
+        auto summary = summarise(micros);
+        report << "seek latency (" << (deck.isMemoryMapped() ? "memory-mapped" : "stream") << "): "
+            << "mean " << juce::String(summary.meanMicros, 2) << " us, "
+            << "p50 " << juce::String(summary.p50Micros, 2) << " us, "
+            << "p99 " << juce::String(summary.p99Micros, 2) << " us\n";
+
+        deck.releaseResources();
+    }
+
+    return report;
+}
+
+juce::String runTimeStretchBenchmark(const juce::File& fixture)
+{
+    const int blockSize = 512;
+    const double renderSeconds = 20.0;
+    const int numBlocks = (int)(renderSeconds * 44100.0 / blockSize);
+    const double rates[] = { 0.5, 0.75, 1.0, 1.25, 1.5, 2.0 };
+    const std::pair<TimeStretchQuality, const char*> qualities[] = {
+        { TimeStretchQuality::low, "low" }, { TimeStretchQuality::medium, "medium" }, { TimeStretchQuality::high, "high" }
+    };
+
+    juce::String report;
+    juce::AudioBuffer<float> buffer(2, blockSize);
+    juce::AudioSourceChannelInfo info(&buffer, 0, blockSize);
+
+    auto measure = [&](bool keyLock, TimeStretchQuality quality, double rate) -> double
+        {
+            PlayerAudio deck;
+            deck.setReadAheadEnabled(false);
+            deck.setDecodedCacheEnabled(false);
+            deck.prepareToPlay(blockSize, 44100.0);
+
+            if (!deck.LoadFile(fixture))
+                return -1.0;
+
+            deck.setKeyLockEnabled(keyLock);
+            deck.setTimeStretchQuality(quality);
+            deck.setPlaybackRate((float)rate);
+            deck.play();
+            deck.getNextAudioBlock(info);
+
+            auto start = juce::Time::getHighResolutionTicks();
+            for (int i = 0; i < numBlocks; ++i)
+                deck.getNextAudioBlock(info);
+            double elapsed = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+
+            deck.releaseResources();
+            return elapsed / renderSeconds;
+        };
+
+    report << "time stretch real-time factor per deck (lower is better, 1.0 = all of one core):\n";
+    report << "  key lock off, 1.0x: " << juce::String(measure(false, TimeStretchQuality::medium, 1.0), 5) << "\n";
+
+    for (auto& quality : qualities)
+    {
+        report << "  key lock " << quality.second << ":";
+        for (auto rate : rates)
+            report << "  " << juce::String(rate, 2) << "x " << juce::String(measure(true, quality.first, rate), 5);
+        report << "\n";
+    }
+
+    return report;
+}
+
+juce::String runResamplerBenchmark()
+{
+    const double outputRate = 48000.0, toneHz = 1000.0;
+    const int blockSize = 512;
+    const int outputSamples = 1 << 18;
+    const int settleSamples = 4096;  // skip the kernels' start-up from silence
+    const ResamplerQuality tiers[] = { ResamplerQuality::linear, ResamplerQuality::cubic, ResamplerQuality::sinc };
+
+    // upsampling, then speeds and a file rate that decimate
+    struct Case { double inputRate, speed; };
+    const Case cases[] = { { 44100.0, 1.0 }, { 44100.0, 1.37 }, { 44100.0, 2.0 }, { 96000.0, 1.0 } };
+
+    // A 1 kHz tone, plus one just below the input's Nyquist wherever the speed carries it past the
+    // output's: that one should be filtered away, so whatever of it folds back counts as noise.
+    auto makeTestSignal = [&](const Case& c)
+        {
+            const double highHz = 0.45 * c.inputRate;
+            const bool withHighTone = highHz * c.speed > outputRate * 0.5;
+            const int length = (int)(outputSamples * c.speed * c.inputRate / outputRate) + 8192;
+
+            juce::AudioBuffer<float> signal(2, length);
+            for (int i = 0; i < length; ++i)
+            {
+                double s = 0.5 * std::sin(juce::MathConstants<double>::twoPi * toneHz * i / c.inputRate);
+                if (withHighTone)
+                    s += 0.25 * std::sin(juce::MathConstants<double>::twoPi * highHz * i / c.inputRate);
+
+                signal.setSample(0, i, (float)s);
+                signal.setSample(1, i, (float)s);
+            }
+            return signal;
+        };
+
+    juce::String report;
+    report << "resampler, 1 kHz tone rendered at 48 kHz, with a tone above the output's Nyquist when decimating\n"
+           << "(ns per output sample per channel, THD+N):\n";
+
+    juce::AudioBuffer<float> output(2, outputSamples);
+
+    for (auto tier : tiers)
+    {
+        report << "  " << juce::String(Resampler::getName(tier)).paddedRight(' ', 7) << ":";
+
+        for (auto& c : cases)
+        {
+            auto signal = makeTestSignal(c);
+            juce::MemoryAudioSource input(signal, false);
+            VarispeedSource varispeed(input);
+            varispeed.setSourceSampleRate(c.inputRate);
+            varispeed.setSpeed(c.speed);
+            varispeed.setQuality(tier);
+            varispeed.prepareToPlay(blockSize, outputRate);
+
+            auto start = juce::Time::getHighResolutionTicks();
+            for (int done = 0; done < outputSamples; done += blockSize)
+                varispeed.getNextAudioBlock(juce::AudioSourceChannelInfo(&output, done, juce::jmin(blockSize, outputSamples - done)));
+            double elapsed = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+
+            varispeed.releaseResources();
+
+            const double omega = juce::MathConstants<double>::twoPi * toneHz * c.speed / outputRate;
+            const double thdN = measureThdPlusNoise(output.getReadPointer(0, settleSamples), outputSamples - settleSamples, omega);
+
+            report << "  " << juce::String(c.inputRate / 1000.0, 1) << "k " << juce::String(c.speed, 2) << "x "
+                << juce::String(elapsed * 1.0e9 / (outputSamples * 2.0), 2) << " ns, " << juce::String(thdN, 1) << " dB";
+        }
+
+        report << "\n";
+    }
+
+    // the kernels alone, vectorised against the scalar reference, upsampling 44.1 kHz
+    const int kernelBlock = 256;
+    const int repeats = 20000;
+    const double kernelRatio = cases[0].inputRate / outputRate;
+    const auto tone = makeTestSignal(cases[0]);
+    std::vector<int> indices((size_t)kernelBlock);
+    std::vector<float> fractions((size_t)kernelBlock), result((size_t)kernelBlock);
+    for (int i = 0; i < kernelBlock; ++i)
+    {
+        const double position = Resampler::maxHistory + i * kernelRatio;
+        indices[(size_t)i] = (int)position;
+        fractions[(size_t)i] = (float)(position - (int)position);
+    }
+
+    report << "resampler kernels only (ns per sample, SIMD / scalar):";
+    for (auto tier : tiers)
+    {
+        double ns[2] = {};
+        for (int scalar = 0; scalar < 2; ++scalar)
+        {
+            auto start = juce::Time::getHighResolutionTicks();
+            for (int r = 0; r < repeats; ++r)
+            {
+                if (scalar != 0)
+                    Resampler::processScalar(tier, kernelRatio, tone.getReadPointer(0), indices.data(), fractions.data(), result.data(), kernelBlock);
+                else
+                    Resampler::process(tier, kernelRatio, tone.getReadPointer(0), indices.data(), fractions.data(), result.data(), kernelBlock);
+            }
+            ns[scalar] = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start) * 1.0e9
+                / ((double)repeats * kernelBlock);
+        }
+
+        report << "  " << Resampler::getName(tier) << " " << juce::String(ns[0], 2) << " / " << juce::String(ns[1], 2);
+    }
+    report << "\n";
+
+    return report;
+}
+
+juce::String runGainPanBenchmark()
+{
+    const int blockSize = 512;
+    const int numBlocks = 100000;
+
+    juce::AudioBuffer<float> source(2, blockSize), work(2, blockSize);
+    juce::Random random(7);
+    for (int chan = 0; chan < 2; ++chan)
+        for (int i = 0; i < blockSize; ++i)
+            source.setSample(chan, i, random.nextFloat() - 0.5f);
+
+    // every block starts from fresh audio, so repeated gains never decay into denormals
+    auto time = [&](auto&& renderBlock) -> double
+        {
+            auto start = juce::Time::getHighResolutionTicks();
+            for (int block = 0; block < numBlocks; ++block)
+            {
+                work.makeCopyOf(source, true);
+                renderBlock(block);
+            }
+            return juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start) * 1.0e9
+                / ((double)numBlocks * blockSize);
+        };
+
+    auto copyOnly = time([](int) {});
+    juce::String report;
+    report << "gain/pan per deck (ns per stereo sample, after " << juce::String(copyOnly, 3) << " ns of buffer copy):\n";
+
+    for (bool moving : { false, true })
+    {
+        // the gain slider either rests or moves on every block
+        auto gainFor = [moving](int block) { return moving ? 0.8f + 0.1f * (float)(block & 1) : 0.8f; };
+        auto panFor = [moving](int block) { return moving ? 0.3 + 0.4 * (double)(block & 1) : 0.3; };
+
+        // as before: the transport's gain ramp, then one linear-law applyGain per side
+        float lastGain = gainFor(0);
+        auto threePass = time([&](int block)
+            {
+                const float gain = gainFor(block);
+                const double pan = panFor(block);
+                for (int chan = 0; chan < 2; ++chan)
+                    work.applyGainRamp(chan, 0, blockSize, lastGain, gain);
+                work.applyGain(0, 0, blockSize, 1.0f - (float)pan);
+                work.applyGain(1, 0, blockSize, (float)pan);
+                lastGain = gain;
+            });
+
+        GainPanStage stage;
+        stage.prepare(44100.0);
+        auto fused = time([&](int block)
+            {
+                stage.setTargets(gainFor(block), panFor(block));
+                stage.process(work, 0, blockSize);
+            });
+
+        report << "  " << (moving ? "moving " : "steady ") << " three-pass " << juce::String(threePass - copyOnly, 3)
+            << " ns, fused " << juce::String(fused - copyOnly, 3) << " ns\n";
+    }
+
+    return report;
+}
+
+juce::String runMixerBenchmark(const juce::File& fixture)
+{
+    const int deckCounts[] = { 2, 4, 8, 16 };
+    juce::String report;
+
+    report << "mixer callback per " << mixerBlockSize << "-sample block (all playing / half stopped):\n";
+
+    for (auto numDecks : deckCounts)
+    {
+        report << "  " << juce::String(numDecks).paddedLeft(' ', 2) << " decks:";
+
+        for (bool halfStopped : { false, true })
+        {
+            TimingSummary summary;
+            if (!measureMixerCallback(fixture, numDecks, halfStopped, 0, summary))
+                return "mixer: could not load " + fixture.getFullPathName() + "\n";
+
+            report << "  " << formatCallbackTiming(summary);
+        }
+
+        report << "\n";
+    }
+
+    return report;
+}
+
+juce::String runParallelMixerBenchmark(const juce::File& fixture)
+{
+    const int deckCounts[] = { 1, 2, 4, 8, 16 };
+    const int renderThreads = juce::jlimit(1, 3, juce::SystemStats::getNumCpus() - 1);
+    juce::String report;
+
+    report << "mixer callback, serial vs " << renderThreads << " render thread(s) + callback thread:\n";
+
+    for (auto numDecks : deckCounts)
+    {
+        TimingSummary serial, parallel;
+        if (!measureMixerCallback(fixture, numDecks, false, 0, serial)
+            || !measureMixerCallback(fixture, numDecks, false, renderThreads, parallel))
+            return "parallel mixer: could not load " + fixture.getFullPathName() + "\n";
+
+        report << "  " << juce::String(numDecks).paddedLeft(' ', 2) << " decks:  serial " << formatCallbackTiming(serial)
+            << "  parallel " << formatCallbackTiming(parallel) << "\n";
+    }
+
+    return report;
+}
+
+namespace
+{
+    constexpr double microSampleRate = 44100.0;
+
+    // A result object: the benchmark's name, its parameters, then the timing summary
+    juce::var makeResult(const juce::String& name, std::initializer_list<std::pair<const char*, juce::var>> parameters,
+        const TimingSummary& summary)
+    {
+        auto* result = new juce::DynamicObject();
+        result->setProperty("name", name);
+        for (auto& parameter : parameters)
+            result->setProperty(parameter.first, parameter.second);
+        result->setProperty("mean_us", summary.meanMicros);
+        result->setProperty("p50_us", summary.p50Micros);
+        result->setProperty("p99_us", summary.p99Micros);
+        return juce::var(result);
+    }
+
+    // A deck as the benchmarks use it: no read-ahead thread and no shared cache, so
+    // every measurement includes its own decoding
+    std::unique_ptr<PlayerAudio> createBenchDeck(int blockSize)
+    {
+        auto deck = std::make_unique<PlayerAudio>();
+        deck->setReadAheadEnabled(false);
+        deck->setDecodedCacheEnabled(false);
+        deck->prepareToPlay(blockSize, microSampleRate);
+        return deck;
+    }
+
+    void benchmarkRenderBlock(const juce::File& fixture, const juce::String& format, juce::Array<juce::var>& results)
+    {
+        for (int blockSize : { 64, 128, 256, 512, 1024, 2048 })
+        {
+            auto deck = createBenchDeck(blockSize);
+            if (!deck->LoadFile(fixture))
+                return;
+
+            deck->play();
+
+            // about 20 seconds of audio per block size
+            const int numBlocks = (int)(20.0 * microSampleRate / blockSize);
+            juce::AudioBuffer<float> buffer(2, blockSize);
+            juce::AudioSourceChannelInfo info(&buffer, 0, blockSize);
+            for (int i = 0; i < 10; ++i)
+                deck->getNextAudioBlock(info);
+
+            juce::Array<double> micros;
+            micros.ensureStorageAllocated(numBlocks);
+            for (int i = 0; i < numBlocks; ++i)
+            {
+                auto start = juce::Time::getHighResolutionTicks();
+                deck->getNextAudioBlock(info);
+                micros.add(ticksToMicros(juce::Time::getHighResolutionTicks() - start));
+            }
+
+            auto summary = summarise(micros);
+            auto result = makeResult("render_block", { { "format", format }, { "block_size", blockSize } }, summary);
+            result.getDynamicObject()->setProperty("ns_per_sample", summary.meanMicros * 1000.0 / blockSize);
+            results.add(result);
+
+            deck->releaseResources();
+        }
+    }
+
+    void benchmarkLoadFile(const juce::File& fixture, const juce::String& format, juce::Array<juce::var>& results)
+    {
+        const int numLoads = 50;
+        auto deck = createBenchDeck(512);
+        juce::Array<double> micros;
+
+        for (int i = 0; i < numLoads; ++i)
+        {
+            auto start = juce::Time::getHighResolutionTicks();
+            if (!deck->LoadFile(fixture))
+                return;
+            micros.add(ticksToMicros(juce::Time::getHighResolutionTicks() - start));
+        }
+
+        results.add(makeResult("load_file", { { "format", format } }, summarise(micros)));
+        deck->releaseResources();
+    }
+
+    void benchmarkSeek(const juce::File& fixture, const juce::String& format, juce::Array<juce::var>& results)
+    {
+        const int numSeeks = 1000;
+        const int blockSize = 512;
+        auto deck = createBenchDeck(blockSize);
+        if (!deck->LoadFile(fixture))
+            return;
+
+        deck->play();
+
+        juce::AudioBuffer<float> buffer(2, blockSize);
+        juce::AudioSourceChannelInfo info(&buffer, 0, blockSize);
+        juce::Random random(42);
+        juce::Array<double> micros;
+        const double length = deck->getLength();
+
+        // the call itself plus the block that lands on the new position
+        for (int i = 0; i < numSeeks; ++i)
+        {
+            auto start = juce::Time::getHighResolutionTicks();
+            deck->setPosition(random.nextDouble() * length * 0.95);
+            deck->getNextAudioBlock(info);
+            micros.add(ticksToMicros(juce::Time::getHighResolutionTicks() - start));
+        }
+
+        results.add(makeResult("seek", { { "format", format }, { "memory_mapped", deck->isMemoryMapped() } },
+            summarise(micros)));
+        deck->releaseResources();
+    }
+
+    void benchmarkRateSwitch(const juce::File& fixture, const juce::String& format, juce::Array<juce::var>& results)
+    {
+        const int numSwitches = 2000;
+        const int blockSize = 512;
+
+        for (bool keyLock : { false, true })
+        {
+            auto deck = createBenchDeck(blockSize);
+            if (!deck->LoadFile(fixture))
+                return;
+
+            deck->setKeyLockEnabled(keyLock);
+            deck->play();
+
+            juce::AudioBuffer<float> buffer(2, blockSize);
+            juce::AudioSourceChannelInfo info(&buffer, 0, blockSize);
+            deck->getNextAudioBlock(info);
+
+            // the message-thread call, then the block that picks the new rate up
+            juce::Array<double> callMicros, blockMicros;
+            for (int i = 0; i < numSwitches; ++i)
+            {
+                auto start = juce::Time::getHighResolutionTicks();
+                deck->setPlaybackRate((i & 1) != 0 ? 1.1f : 0.9f);
+                auto called = juce::Time::getHighResolutionTicks();
+                deck->getNextAudioBlock(info);
+                auto rendered = juce::Time::getHighResolutionTicks();
+
+                callMicros.add(ticksToMicros(called - start));
+                blockMicros.add(ticksToMicros(rendered - called));
+            }
+
+            results.add(makeResult("rate_switch_call", { { "format", format }, { "key_lock", keyLock } }, summarise(callMicros)));
+            results.add(makeResult("rate_switch_block", { { "format", format }, { "key_lock", keyLock } }, summarise(blockMicros)));
+            deck->releaseResources();
+        }
+    }
+
+    // Sessions as PlayerGUI restores them, listing numEntries existing (empty) track files: once from
+    // the old text file, which is carried over into the journal, then from that journal
+    void benchmarkSession(const juce::File& directory, juce::Array<juce::var>& results)
+    {
+        const juce::String slotName = "Benchmark";
+        auto sessionFile = PlayerGUI::getLegacySessionFile(slotName);
+        auto journalFile = PlayerGUI::getSessionJournalFile(slotName);
+        auto journalAside = directory.getChildFile("session.journal");
+        auto trackDirectory = directory.getChildFile("session_tracks");
+        trackDirectory.createDirectory();
+
+        auto singleRun = [](juce::int64 elapsedTicks)
+            {
+                // one run each: the large cases take far too long to repeat
+                TimingSummary summary;
+                summary.meanMicros = summary.p50Micros = summary.p99Micros = ticksToMicros(elapsedTicks);
+                return summary;
+            };
+
+        for (int numEntries : { 10, 1000, 100000 })
+        {
+            juce::String data;
+            data << "\n0\n---MARKERS---\n---END_MARKERS---\n---PLAYLIST---\n";
+            for (int i = 0; i < numEntries; ++i)
+            {
+                // loading skips entries whose file has gone, so every one has to exist
+                auto track = trackDirectory.getChildFile("track_" + juce::String(i).paddedLeft('0', 6) + ".wav");
+                if (!track.existsAsFile())
+                    track.create();
+                data << track.getFullPathName() << "," << (i % 300) << "\n";
+            }
+            data << "---END_PLAYLIST---\n";
+
+            // no session yet, so the constructor loads nothing
+            sessionFile.deleteFile();
+            journalFile.deleteFile();
+            PlayerAudio deck;
+            auto gui = std::make_unique<PlayerGUI>(deck, slotName);
+            sessionFile.replaceWithText(data);
+
+            auto start = juce::Time::getHighResolutionTicks();
+            gui->loadLastSession();
+            auto loaded = juce::Time::getHighResolutionTicks();
+
+            // the load queued the carried-over session; keep its write out of the save's time
+            gui->getSessionJournal().waitUntilWritten(60000);
+
+            auto saveStart = juce::Time::getHighResolutionTicks();
+            gui->saveLastSession();
+            auto queued = juce::Time::getHighResolutionTicks();
+            gui->getSessionJournal().waitUntilWritten(60000);
+            auto saved = juce::Time::getHighResolutionTicks();
+
+            results.add(makeResult("session_load", { { "entries", numEntries }, { "format", "text" } }, singleRun(loaded - start)));
+            // the call returns once the records are queued; the save is done once the writer has drained
+            results.add(makeResult("session_save", { { "entries", numEntries } }, singleRun(saved - saveStart)));
+            results.add(makeResult("session_save_call", { { "entries", numEntries } }, singleRun(queued - saveStart)));
+
+            // the journal is complete once its writer has drained; restore from it into a fresh deck
+            gui.reset();
+            sessionFile.deleteFile();
+            journalFile.moveFileTo(journalAside);
+            gui = std::make_unique<PlayerGUI>(deck, slotName);
+            journalAside.moveFileTo(journalFile);
+
+            start = juce::Time::getHighResolutionTicks();
+            gui->loadLastSession();
+            loaded = juce::Time::getHighResolutionTicks();
+
+            results.add(makeResult("session_load", { { "entries", numEntries }, { "format", "journal" } }, singleRun(loaded - start)));
+
+            gui.reset();
+            journalFile.deleteFile();
+        }
+    }
+
+    // The playlist store on its own, at library sizes: paths are synthetic (twelve tracks per
+    // album folder), so nothing here touches the disk
+    void benchmarkPlaylist(const juce::File& directory, juce::Array<juce::var>& results)
+    {
+        const auto root = directory.getChildFile("library");
+        juce::Random random(42);
+
+        auto makePaths = [&root](int first, int count)
+            {
+                juce::StringArray paths;
+                paths.ensureStorageAllocated(count);
+                for (int i = first; i < first + count; ++i)
+                    paths.add(root.getChildFile("album_" + juce::String(i / 12)).getChildFile("track_" + juce::String(i) + ".flac").getFullPathName());
+                return paths;
+            };
+
+        auto singleRun = [](juce::int64 startTicks)
+            {
+                TimingSummary summary;
+                summary.meanMicros = summary.p50Micros = summary.p99Micros = ticksToMicros(juce::Time::getHighResolutionTicks() - startTicks);
+                return summary;
+            };
+
+        for (int numEntries : { 1000, 100000, 1000000 })
+        {
+            auto paths = makePaths(0, numEntries);
+
+            // restore as the session does it: every line becomes a File and is checked for duplicates
+            PlaylistModel playlist;
+            auto start = juce::Time::getHighResolutionTicks();
+            playlist.reserve(numEntries);
+            for (auto& path : paths)
+                playlist.add(juce::File(path));
+            results.add(makeResult("playlist_restore", { { "entries", numEntries }, { "store", "model" } }, singleRun(start)));
+
+            // the juce::Array it replaced is quadratic, so it is only timed at the smallest size
+            if (numEntries <= 1000)
+            {
+                juce::Array<juce::File> array;
+                start = juce::Time::getHighResolutionTicks();
+                for (auto& path : paths)
+                {
+                    juce::File file(path);
+                    if (array.indexOf(file) == -1)
+                        array.add(file);
+                }
+                results.add(makeResult("playlist_restore", { { "entries", numEntries }, { "store", "juce_array" } }, singleRun(start)));
+            }
+
+            juce::Array<double> lookupMicros;
+            for (int i = 0; i < 1000; ++i)
+            {
+                juce::File file(paths[random.nextInt(numEntries)]);
+                auto lookupStart = juce::Time::getHighResolutionTicks();
+                const bool found = playlist.contains(file);
+                lookupMicros.add(ticksToMicros(juce::Time::getHighResolutionTicks() - lookupStart));
+                jassertquiet(found);
+            }
+            results.add(makeResult("playlist_lookup", { { "entries", numEntries } }, summarise(lookupMicros)));
+
+            juce::Array<double> addMicros;
+            for (auto& path : makePaths(numEntries, 1000))
+            {
+                juce::File file(path);
+                auto addStart = juce::Time::getHighResolutionTicks();
+                playlist.add(file);
+                addMicros.add(ticksToMicros(juce::Time::getHighResolutionTicks() - addStart));
+            }
+            results.add(makeResult("playlist_add", { { "entries", numEntries } }, summarise(addMicros)));
+
+            // one frame paints the visible rows through the display cache, as paintListBoxItem does;
+            // scrolling three rows a frame from a few random places
+            constexpr int visibleRows = 30;
+            juce::Array<double> frameMicros;
+            for (int jump = 0; jump < 10; ++jump)
+            {
+                int top = random.nextInt(juce::jmax(1, playlist.size() - 1000));
+                for (int frame = 0; frame < 200; ++frame, top += 3)
+                {
+                    auto frameStart = juce::Time::getHighResolutionTicks();
+                    int characters = 0;
+                    for (int row = top; row < juce::jmin(top + visibleRows, playlist.size()); ++row)
+                    {
+                        auto* text = playlist.findRowText(row);
+                        if (text == nullptr)
+                            text = &playlist.cacheRowText(row, { playlist.getFileName(row), {} });
+                        characters += text->name.length();
+                    }
+                    frameMicros.add(ticksToMicros(juce::Time::getHighResolutionTicks() - frameStart));
+                    jassertquiet(characters > 0);
+                }
+            }
+            results.add(makeResult("playlist_scroll", { { "entries", numEntries }, { "visible_rows", visibleRows } }, summarise(frameMicros)));
+        }
+    }
+}
+
+juce::var runMicroBenchmarks(const juce::File& directory)
+{
+    juce::Array<juce::var> results;
+
+    for (juce::String format : { "wav", "flac" })
+    {
+        auto fixture = createBenchmarkFixture(directory, 60.0, microSampleRate, format);
+        benchmarkRenderBlock(fixture, format, results);
+        benchmarkLoadFile(fixture, format, results);
+        benchmarkSeek(fixture, format, results);
+        benchmarkRateSwitch(fixture, format, results);
+    }
+
+    benchmarkSession(directory, results);
+    benchmarkPlaylist(directory, results);
+
+    auto* root = new juce::DynamicObject();
+    root->setProperty("schema", 1);
+    root->setProperty("version", juce::JUCEApplication::getInstance() != nullptr
+        ? juce::JUCEApplication::getInstance()->getApplicationVersion() : juce::String());
+    root->setProperty("timestamp", juce::Time::getCurrentTime().toISO8601(true));
+    root->setProperty("cpu", juce::SystemStats::getCpuModel());
+    root->setProperty("cores", juce::SystemStats::getNumCpus());
+    root->setProperty("os", juce::SystemStats::getOperatingSystemName());
+    root->setProperty("results", results);
+    return juce::var(root);
+}
+
+void runBenchmarks(const juce::String& commandLine)
+{
+    auto dir = juce::File::getSpecialLocation(juce::File::tempDirectory).getChildFile("AudioPlayerBench");
+    dir.createDirectory();
+
+    if (commandLine.contains("--json"))
+    {
+        auto json = juce::JSON::toString(runMicroBenchmarks(dir));
+        auto target = commandLine.fromFirstOccurrenceOf("--json=", false, false).upToFirstOccurrenceOf(" ", false, false).unquoted();
+
+        if (target.isEmpty())
+            std::cout << json << std::endl;
+        else if (!juce::File::getCurrentWorkingDirectory().getChildFile(target).replaceWithText(json))
+            std::cerr << "could not write " << target << std::endl;
+        return;
+    }
+
+    auto fixture = createBenchmarkFixture(dir, 300.0);
+    std::cout << runSeekLatencyBenchmark(fixture) << std::flush;
+    std::cout << runTimeStretchBenchmark(fixture) << std::flush;
+    std::cout << runResamplerBenchmark() << std::flush;
+    std::cout << runGainPanBenchmark() << std::flush;
+    std::cout << runMixerBenchmark(fixture) << std::flush;
+    std::cout << runParallelMixerBenchmark(fixture) << std::flush;
+}
@@ -0,0 +1,48 @@
+/*
+  ==============================================================================
+
+    Benchmarks.h
+    Created: 17 Oct 2026 12:15:03pm
+
+    Run with:  AudioPlayer --benchmark
+               AudioPlayer --benchmark --json[=results.json]
+    Results go to stdout (or the named file); the window is never opened.
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// Writes a synthetic stereo 16-bit WAV (or FLAC, for "flac") of the given length, returns the file
+juce::File createBenchmarkFixture(const juce::File& directory, double seconds, double sampleRate = 44100.0,
+    const juce::String& format = "wav");
+
+// setPosition() + first rendered block, streamed reader vs memory-mapped reader
+juce::String runSeekLatencyBenchmark(const juce::File& fixture);
+
+// Real-time factor (render time / audio time) of one key-locked deck at 0.5x to 2.0x, per quality
+juce::String runTimeStretchBenchmark(const juce::File& fixture);
+
+// Cost and distortion of each resampler tier converting a 1 kHz tone from 44.1 to 48 kHz,
+// plus the vectorised kernels against their scalar versions
+juce::String runResamplerBenchmark();
+
+// The fused gain/mute/pan stage against the transport gain pass plus two pan passes it replaced
+juce::String runGainPanBenchmark();
+
+// Callback time of the deck mixer with 2, 4, 8 and 16 decks, all playing and with half stopped
+juce::String runMixerBenchmark(const juce::File& fixture);
+
+// Mixer callback time against deck count, rendering decks serially and on worker threads
+juce::String runParallelMixerBenchmark(const juce::File& fixture);
+
+// The playback hot paths on WAV and FLAC fixtures, for tracking regressions between releases:
+// PlayerAudio::getNextAudioBlock at several block sizes, LoadFile, setPosition and
+// setPlaybackRate, PlayerGUI session save and load (from the old text file and from the
+// journal) with 10, 1k and 100k playlist entries, and
+// restore, add, lookup and scrolling on the playlist store at 1k, 100k and 1M entries.
+// One JSON object per measurement, all timings in microseconds.
+juce::var runMicroBenchmarks(const juce::File& directory);
+
+void runBenchmarks(const juce::String& commandLine);
@@ -0,0 +1,115 @@
+/*
+  ==============================================================================
+
+    DeckControl.h
+    Created: 17 Oct 2026 5:12:40pm
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "TimeStretchSource.h"
+#include "Resampler.h"
+#include "GainRamp.h"
+
+// A transport action sent from the message thread to a deck's audio callback
+struct DeckCommand
+{
+    enum class Type
+    {
+        play,
+        stop,
+        seek,
+        restart   // back to the start, fading in from silence
+    };
+
+    Type type = Type::stop;
+    juce::int64 position = 0;      // seek target, in the track's own samples
+    juce::uint32 generation = 0;   // the track the command was issued against
+};
+
+// The continuous values the audio callback reads every block
+struct DeckParameters
+{
+    float gain = 1.0f;
+    bool muted = false;                // silences without losing gain
+    double pan = 0.5;                  // constant-power, 0.5 = centre
+    bool segmentLooping = false;
+    juce::int64 loopStartSample = -1;  // in the deck source's sample timeline
+    juce::int64 loopEndSample = -1;
+    int seamCrossfadeSamples = 0;
+    double varispeed = 1.0;            // resampling speed, pitch follows
+    double nudge = 0.0;                // temporary offset on top of varispeed
+    double stretchRatio = 0.0;         // key lock tempo; 0 = off
+    TimeStretchQuality stretchQuality = TimeStretchQuality::medium;
+    ResamplerQuality resamplerQuality = ResamplerQuality::sinc;
+    double transportFadeSeconds = 0.05; // fade on play, stop and restart
+    CrossfadeCurve transportFadeCurve = CrossfadeCurve::sCurve;
+};
+
+// Triple buffer handing the latest copy of a value from one writer thread to one
+// reader thread. Neither side ever waits, and the reader always gets a complete copy.
+template <typename Type>
+class ParameterSnapshot
+{
+public:
+    // Writer only
+    void publish(const Type& newValue)
+    {
+        slots[writeIndex] = newValue;
+        writeIndex = shared.exchange(writeIndex | newDataFlag, std::memory_order_acq_rel) & indexMask;
+    }
+
+    // Reader only; copies the newest value into dest and returns true if one was published since the last call
+    bool fetch(Type& dest)
+    {
+        if ((shared.load(std::memory_order_relaxed) & newDataFlag) == 0)
+            return false;
+
+        readIndex = shared.exchange(readIndex, std::memory_order_acq_rel) & indexMask;
+        dest = slots[readIndex];
+        return true;
+    }
+
+private:
+    static constexpr int indexMask = 3;
+    static constexpr int newDataFlag = 4;
+
+    Type slots[3]{};
+    int writeIndex = 0;
+    std::atomic<int> shared{ 1 };
+    int readIndex = 2;
+};
+
+// Hands deck commands from the message thread to the audio callback without a queue
+// that can fill up: the callback only ever needs the latest seek and the latest
+// transport request, so a newer one replaces one not yet picked up. A restart is
+// also a seek to the start, which a later seek overrides.
+class DeckCommands
+{
+public:
+    // Producer only
+    void push(const DeckCommand& command)
+    {
+        if (command.type == DeckCommand::Type::seek || command.type == DeckCommand::Type::restart)
+            seeks.publish({ DeckCommand::Type::seek, command.type == DeckCommand::Type::seek ? command.position : 0, command.generation });
+
+        if (command.type != DeckCommand::Type::seek)
+            transport.publish(command);
+    }
+
+    // Consumer only; calls handler with the pending seek, then the pending transport request
+    template <typename Handler>
+    void drain(Handler&& handler)
+    {
+        if (seeks.fetch(pending))
+            handler(pending);
+        if (transport.fetch(pending))
+            handler(pending);
+    }
+
+private:
+    ParameterSnapshot<DeckCommand> seeks, transport;
+    DeckCommand pending;  // consumer only
+};
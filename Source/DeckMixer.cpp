@@ -0,0 +1,285 @@
+/*
+  ==============================================================================
+
+    DeckMixer.cpp
+    Created: 18 Oct 2026 12:24:36am
+
+  ==============================================================================
+*/
+
+#include "DeckMixer.h"
+#include "SimdOps.h"
+
+namespace
+{
+    constexpr int channelAlignment = 32;  // bytes; enough for SSE and NEON, and for AVX later
+
+    // dest += source; both channel starts are aligned
+    void accumulate(float* dest, const float* source, int numSamples)
+    {
+        int i = 0;
+
+       #if MELODYMIX_SIMD_AVAILABLE
+        using namespace simd;
+        for (; i + width <= numSamples; i += width)
+            storeAligned(dest + i, add(loadAligned(dest + i), loadAligned(source + i)));
+       #endif
+
+        for (; i < numSamples; ++i)
+            dest[i] += source[i];
+    }
+}
+
+DeckMixer::~DeckMixer()
+{
+    releaseResources();
+}
+
+void DeckMixer::setRenderThreads(int numThreads)
+{
+    const juce::ScopedLock sl(configLock);
+
+    if (numThreads == getRenderThreads())
+        return;
+
+    auto newScheduler = numThreads > 0 ? std::make_unique<DeckRenderScheduler>(numThreads) : nullptr;
+    activeScheduler = newScheduler.get();
+
+    // the old pool may still be running the callback in flight
+    waitForCallbackInFlight();
+
+    scheduler = std::move(newScheduler);
+}
+
+bool DeckMixer::addDeck(PlayerAudio& deck)
+{
+    const juce::ScopedLock sl(configLock);
+
+    for (auto& slot : slots)
+    {
+        if (slot.load() == &deck)
+            return true;
+    }
+
+    for (auto& slot : slots)
+    {
+        if (slot.load() != nullptr)
+            continue;
+
+        // ready before the callback can see it
+        deck.setOutputLatency(outputLatency);
+        if (prepared)
+            deck.prepareToPlay(blockCapacity, currentSampleRate);
+        deck.setAttached(prepared);
+
+        slot = &deck;
+        return true;
+    }
+
+    return false;
+}
+
+void DeckMixer::removeDeck(PlayerAudio& deck)
+{
+    const juce::ScopedLock sl(configLock);
+
+    for (auto& slot : slots)
+    {
+        if (slot.load() != &deck)
+            continue;
+
+        slot = nullptr;
+
+        // a callback that started before the store may still be rendering the deck
+        waitForCallbackInFlight();
+
+        deck.setAttached(false);
+        if (prepared)
+            deck.releaseResources();
+        return;
+    }
+}
+
+void DeckMixer::setOutputLatency(double seconds)
+{
+    const juce::ScopedLock sl(configLock);
+    outputLatency = seconds;
+
+    for (auto& slot : slots)
+        if (auto* deck = slot.load())
+            deck->setOutputLatency(seconds);
+}
+
+int DeckMixer::getNumDecks() const
+{
+    int count = 0;
+    for (auto& slot : slots)
+        count += slot.load() != nullptr ? 1 : 0;
+    return count;
+}
+
+void DeckMixer::allocateBuffers(int blockSize)
+{
+    // every channel starts on an aligned boundary: the mix, then one stereo buffer per slot
+    const int floatsPerAlignment = channelAlignment / (int)sizeof(float);
+    const int stride = (blockSize + floatsPerAlignment - 1) / floatsPerAlignment * floatsPerAlignment;
+    const int numBuffers = (1 + maxDecks) * numChannels;
+
+    storage.allocate((size_t)(stride * numBuffers + floatsPerAlignment), true);
+    float* base = juce::snapPointerToAlignment(storage.get(), channelAlignment);
+
+    for (int chan = 0; chan < numChannels; ++chan)
+        mixChannels[(size_t)chan] = base + chan * stride;
+
+    for (int deck = 0; deck < maxDecks; ++deck)
+        for (int chan = 0; chan < numChannels; ++chan)
+            deckChannels[(size_t)deck][(size_t)chan] = base + ((1 + deck) * numChannels + chan) * stride;
+
+    blockCapacity = blockSize;
+}
+
+void DeckMixer::prepareToPlay(int samplesPerBlockExpected, double sampleRate)
+{
+    const juce::ScopedLock sl(configLock);
+
+    allocateBuffers(juce::jmax(1, samplesPerBlockExpected));
+    currentSampleRate = sampleRate;
+    callbackStats.prepare(sampleRate);
+
+    for (auto& slot : slots)
+    {
+        if (auto* deck = slot.load())
+        {
+            deck->prepareToPlay(blockCapacity, currentSampleRate);
+            deck->setAttached(true);
+        }
+    }
+
+    prepared = true;
+}
+
+void DeckMixer::releaseResources()
+{
+    const juce::ScopedLock sl(configLock);
+
+    if (!prepared)
+        return;
+
+    // no callback runs from here until the next prepareToPlay
+    for (auto& slot : slots)
+    {
+        if (auto* deck = slot.load())
+        {
+            deck->setAttached(false);
+            deck->releaseResources();
+        }
+    }
+
+    prepared = false;
+}
+
+void DeckMixer::getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill)
+{
+    auto startTicks = juce::Time::getHighResolutionTicks();
+    ++callbackEpoch;
+
+    if (blockCapacity <= 0)
+    {
+        bufferToFill.clearActiveBufferRegion();
+        ++callbackEpoch;
+        return;
+    }
+
+    // a device may hand over a bigger block than it announced; mix it in pieces
+    for (int done = 0; done < bufferToFill.numSamples; done += blockCapacity)
+        mixChunk(bufferToFill, done, juce::jmin(blockCapacity, bufferToFill.numSamples - done));
+
+    ++callbackEpoch;
+    callbackStats.record(startTicks, juce::Time::getHighResolutionTicks(), bufferToFill.numSamples);
+}
+
+void DeckMixer::waitForCallbackInFlight() const
+{
+    // Called after clearing what the callback reads. A callback that saw the old value had
+    // already made the epoch odd, so only that one is waited for: once the epoch moves on it
+    // has finished, even if the device starts the next callback straight away.
+    const auto epoch = callbackEpoch.load();
+    if ((epoch & 1) == 0)
+        return;
+
+    while (callbackEpoch.load() == epoch)
+        juce::Thread::yield();
+}
+
+void DeckMixer::renderJob(void* mixer, int jobIndex)
+{
+    auto& self = *static_cast<DeckMixer*>(mixer);
+    const auto slot = (size_t)self.jobSlots[(size_t)jobIndex];
+
+    // refers to the slot's preallocated channels; no allocation here
+    juce::AudioBuffer<float> deckBuffer(self.deckChannels[slot].data(), numChannels, self.chunkSamples);
+    self.slotHasAudio[slot] = self.jobDecks[(size_t)jobIndex]->renderNextBlock(
+        juce::AudioSourceChannelInfo(&deckBuffer, 0, self.chunkSamples));
+}
+
+void DeckMixer::mixChunk(const juce::AudioSourceChannelInfo& bufferToFill, int offset, int numSamples)
+{
+    int numJobs = 0;
+
+    for (size_t i = 0; i < slots.size(); ++i)
+    {
+        slotHasAudio[i] = false;
+
+        // read once: removeDeck may empty the slot mid-callback, but waits for us before releasing the deck
+        slotDecks[i] = slots[i].load();
+
+        if (auto* deck = slotDecks[i])
+        {
+            jobSlots[(size_t)numJobs] = (int)i;
+            jobDecks[(size_t)numJobs] = deck;
+            ++numJobs;
+        }
+    }
+
+    chunkSamples = numSamples;
+
+    if (auto* pool = activeScheduler.load())
+        pool->run(numJobs, &DeckMixer::renderJob, this);
+    else
+        for (int job = 0; job < numJobs; ++job)
+            renderJob(this, job);
+
+    // every render has finished; sum in slot order so the result never depends on which thread ran what
+    bool anyAudio = false;
+
+    for (size_t i = 0; i < slots.size(); ++i)
+    {
+        if (!slotHasAudio[i])
+            continue;
+
+        auto mixStart = juce::Time::getHighResolutionTicks();
+
+        for (int chan = 0; chan < numChannels; ++chan)
+        {
+            if (anyAudio)
+                accumulate(mixChannels[(size_t)chan], deckChannels[i][(size_t)chan], numSamples);
+            else
+                juce::FloatVectorOperations::copy(mixChannels[(size_t)chan], deckChannels[i][(size_t)chan], numSamples);
+        }
+
+        anyAudio = true;
+
+        DeckLoadStats::add(slotDecks[i]->getLoadStats().mixTicks, juce::Time::getHighResolutionTicks() - mixStart);
+    }
+
+    auto& output = *bufferToFill.buffer;
+    const int start = bufferToFill.startSample + offset;
+
+    for (int chan = 0; chan < output.getNumChannels(); ++chan)
+    {
+        if (anyAudio && chan < numChannels)
+            output.copyFrom(chan, start, mixChannels[(size_t)chan], numSamples);
+        else
+            output.clear(chan, start, numSamples);
+    }
+}
@@ -0,0 +1,85 @@
+/*
+  ==============================================================================
+
+    DeckMixer.h
+    Created: 18 Oct 2026 12:24:36am
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "PlayerAudio.h"
+#include "DeckRenderScheduler.h"
+
+// Sums any number of decks (up to maxDecks) into a stereo output. Decks can be
+// added and removed while audio runs without the callback ever taking a lock.
+// Every slot renders into its own buffer, preallocated in prepareToPlay and
+// aligned for the SIMD sum; stopped and muted decks are skipped entirely.
+// Deck renders can optionally run in parallel on worker threads; the sum is
+// always taken afterwards, in slot order, so the output matches serial rendering.
+class DeckMixer : public juce::AudioSource
+{
+public:
+    static constexpr int maxDecks = 16;
+
+    DeckMixer() = default;
+    ~DeckMixer() override;
+
+    // Message thread; prepares the deck if the mixer is running. False if every slot is taken.
+    bool addDeck(PlayerAudio& deck);
+    // Message thread; once this returns the callback no longer touches the deck
+    void removeDeck(PlayerAudio& deck);
+    int getNumDecks() const;
+    // Message thread; the deck in a slot, or nullptr
+    PlayerAudio* getDeck(int slot) const { return slots[(size_t)slot].load(); }
+
+    // Any thread; the time from a block being mixed to it being heard. Passed on to every
+    // deck, including those added later, for their heard position.
+    void setOutputLatency(double seconds);
+
+    // Timing of every callback, and per deck through PlayerAudio::getLoadStats()
+    CallbackStats& getCallbackStats() { return callbackStats; }
+
+    // Message thread; 0 renders every deck on the callback thread
+    void setRenderThreads(int numThreads);
+    int getRenderThreads() const { return scheduler != nullptr ? scheduler->getNumWorkers() : 0; }
+
+    void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
+    void releaseResources() override;
+    void getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill) override;
+
+private:
+    static constexpr int numChannels = 2;
+
+    void allocateBuffers(int blockSize);
+    void mixChunk(const juce::AudioSourceChannelInfo& bufferToFill, int offset, int numSamples);
+    static void renderJob(void* mixer, int jobIndex);
+    void waitForCallbackInFlight() const;
+
+    std::array<std::atomic<PlayerAudio*>, maxDecks> slots{};
+    std::atomic<juce::uint32> callbackEpoch{ 0 };  // odd while a callback is running
+    std::unique_ptr<DeckRenderScheduler> scheduler;
+    std::atomic<DeckRenderScheduler*> activeScheduler{ nullptr };
+    CallbackStats callbackStats;
+    double outputLatency = 0.0;  // guarded by configLock
+
+    // guards the prepared state between prepareToPlay and addDeck / removeDeck; never taken by the callback
+    juce::CriticalSection configLock;
+    bool prepared = false;
+    int blockCapacity = 0;
+    double currentSampleRate = 0.0;
+
+    juce::HeapBlock<float> storage;
+    std::array<float*, numChannels> mixChannels{};
+    std::array<std::array<float*, numChannels>, maxDecks> deckChannels{};
+
+    // the current chunk's jobs, written by the callback before the scheduler runs them
+    std::array<int, maxDecks> jobSlots{};
+    std::array<PlayerAudio*, maxDecks> jobDecks{};
+    std::array<bool, maxDecks> slotHasAudio{};
+    std::array<PlayerAudio*, maxDecks> slotDecks{};  // as each slot was read for this chunk
+    int chunkSamples = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DeckMixer)
+};
@@ -0,0 +1,123 @@
+/*
+  ==============================================================================
+
+    DeckRenderScheduler.cpp
+    Created: 18 Oct 2026 1:10:58am
+
+  ==============================================================================
+*/
+
+#include "DeckRenderScheduler.h"
+
+class DeckRenderScheduler::Worker : public juce::Thread
+{
+public:
+    Worker(DeckRenderScheduler& s, int index)
+        : juce::Thread("Deck render " + juce::String(index)), scheduler(s)
+    {
+    }
+
+    void run() override
+    {
+        while (!threadShouldExit())
+        {
+            if (scheduler.runAvailableJobs())
+                continue;
+
+            // announce the sleep before the last look, so a batch published in between still wakes us
+            sleeping = true;
+            if (!scheduler.hasAvailableJobs() && !threadShouldExit())
+                wake.wait(100);
+            sleeping = false;
+        }
+    }
+
+    void wakeIfSleeping()
+    {
+        if (sleeping.load())
+            wake.signal();
+    }
+
+    void stop()
+    {
+        signalThreadShouldExit();
+        wake.signal();
+        stopThread(1000);
+    }
+
+private:
+    DeckRenderScheduler& scheduler;
+    std::atomic<bool> sleeping{ false };
+    juce::WaitableEvent wake;
+};
+
+DeckRenderScheduler::DeckRenderScheduler(int numWorkers)
+{
+    for (int i = 0; i < numWorkers; ++i)
+    {
+        auto* worker = workers.add(std::make_unique<Worker>(*this, i + 1));
+
+        if (!worker->startRealtimeThread(juce::Thread::RealtimeOptions{}.withPriority(9)))
+            worker->startThread(juce::Thread::Priority::highest);
+    }
+}
+
+DeckRenderScheduler::~DeckRenderScheduler()
+{
+    for (auto* worker : workers)
+        worker->stop();
+}
+
+bool DeckRenderScheduler::hasAvailableJobs() const
+{
+    const auto state = claimState.load();
+    return (state & 0xffffffffu) < (state >> 32);
+}
+
+bool DeckRenderScheduler::runAvailableJobs()
+{
+    bool ranAny = false;
+    auto state = claimState.load();
+
+    for (;;)
+    {
+        const auto count = state >> 32;
+        const auto next = state & 0xffffffffu;
+        if (next >= count)
+            return ranAny;
+
+        // an identical state from a later batch is harmless: the job is claimed and run from that batch
+        if (!claimState.compare_exchange_weak(state, state + 1))
+            continue;
+
+        // the batch cannot be replaced while this claimed job is still pending
+        jobFunction(jobContext, (int)next);
+        pendingJobs.fetch_sub(1, std::memory_order_release);
+        ranAny = true;
+        state = claimState.load();
+    }
+}
+
+void DeckRenderScheduler::run(int numJobs, JobFunction function, void* context)
+{
+    if (workers.isEmpty() || numJobs < 2)
+    {
+        for (int i = 0; i < numJobs; ++i)
+            function(context, i);
+        return;
+    }
+
+    jobFunction = function;
+    jobContext = context;
+    pendingJobs.store(numJobs, std::memory_order_relaxed);
+    claimState.store((juce::uint64)numJobs << 32);
+
+    for (auto* worker : workers)
+        worker->wakeIfSleeping();
+
+    runAvailableJobs();
+
+    // the rest are already running on workers
+    while (pendingJobs.load(std::memory_order_acquire) > 0)
+        juce::Thread::yield();
+}
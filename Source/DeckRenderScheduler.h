@@ -0,0 +1,47 @@
+/*
+  ==============================================================================
+
+    DeckRenderScheduler.h
+    Created: 18 Oct 2026 1:10:58am
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// Spreads the independent jobs of one audio callback (a mixer's deck renders)
+// over a small pool of real-time worker threads. Jobs are claimed through a
+// single atomic counter, and the calling thread claims them too, so a batch
+// always completes even if no worker wakes in time; run() returns only once
+// every job has finished. With no workers, or a single job, it is a plain loop.
+class DeckRenderScheduler
+{
+public:
+    using JobFunction = void (*)(void* context, int jobIndex);
+
+    explicit DeckRenderScheduler(int numWorkers);
+    ~DeckRenderScheduler();
+
+    int getNumWorkers() const { return workers.size(); }
+
+    // Audio thread only: calls function(context, i) once for every i in [0, numJobs)
+    void run(int numJobs, JobFunction function, void* context);
+
+private:
+    class Worker;
+
+    bool runAvailableJobs();
+    bool hasAvailableJobs() const;
+
+    juce::OwnedArray<Worker> workers;
+
+    // the current batch: job count in the high 32 bits, next unclaimed index in the low 32
+    std::atomic<juce::uint64> claimState{ 0 };
+    std::atomic<int> pendingJobs{ 0 };
+    // only rewritten once the previous batch has no pending jobs, so a claimed job reads its own batch's
+    JobFunction jobFunction = nullptr;
+    void* jobContext = nullptr;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DeckRenderScheduler)
+};
@@ -0,0 +1,188 @@
+/*
+  ==============================================================================
+
+    DecodedTrackCache.cpp
+    Created: 17 Oct 2026 1:31:55pm
+
+  ==============================================================================
+*/
+
+#include "DecodedTrackCache.h"
+
+DecodedTrackReader::DecodedTrackReader(std::shared_ptr<const DecodedTrack> t)
+    : juce::AudioFormatReader(nullptr, "Decoded cache"), track(std::move(t))
+{
+    sampleRate = track->sampleRate;
+    bitsPerSample = 32;
+    lengthInSamples = track->samples.getNumSamples();
+    numChannels = (unsigned int)track->samples.getNumChannels();
+    usesFloatingPointData = true;
+    metadataValues = track->metadataValues;
+}
+
+bool DecodedTrackReader::readSamples(int* const* destChannels, int numDestChannels, int startOffsetInDestBuffer,
+    juce::int64 startSampleInFile, int numSamples)
+{
+    clearSamplesBeyondAvailableLength(destChannels, numDestChannels, startOffsetInDestBuffer,
+        startSampleInFile, numSamples, lengthInSamples);
+
+    if (numSamples <= 0)
+        return true;
+
+    for (int chan = 0; chan < numDestChannels; ++chan)
+    {
+        if (destChannels[chan] == nullptr)
+            continue;
+
+        auto* dest = reinterpret_cast<float*>(destChannels[chan]) + startOffsetInDestBuffer;
+
+        if (chan < (int)numChannels)
+            juce::FloatVectorOperations::copy(dest, track->samples.getReadPointer(chan, (int)startSampleInFile), numSamples);
+        else
+            juce::FloatVectorOperations::clear(dest, numSamples);
+    }
+
+    return true;
+}
+
+DecodedTrackCache::DecodedTrackCache()
+{
+    formatManager.registerBasicFormats();
+}
+
+DecodedTrackCache::~DecodedTrackCache()
+{
+    shuttingDown = true;
+    decodePool.removeAllJobs(true, 10000);
+}
+
+std::string DecodedTrackCache::makeKey(const juce::File& file)
+{
+    // size and modification time are part of the key so an edited file is decoded again
+    return (file.getFullPathName() + "|" + juce::String(file.getSize())
+        + "|" + juce::String(file.getLastModificationTime().toMilliseconds())).toStdString();
+}
+
+std::shared_ptr<const DecodedTrack> DecodedTrackCache::find(const juce::File& file)
+{
+    auto key = makeKey(file);
+    const juce::ScopedLock sl(lock);
+
+    auto it = index.find(key);
+    if (it == index.end())
+    {
+        ++misses;
+        return nullptr;
+    }
+
+    ++hits;
+    entries.splice(entries.begin(), entries, it->second);
+    return it->second->track;
+}
+
+void DecodedTrackCache::decodeInBackground(const juce::File& file)
+{
+    auto key = makeKey(file);
+
+    {
+        const juce::ScopedLock sl(lock);
+        if (index.count(key) > 0 || pending.count(key) > 0)
+            return;
+        pending.insert(key);
+    }
+
+    decodePool.addJob([this, file, key]
+        {
+            std::shared_ptr<DecodedTrack> track;
+
+            if (std::unique_ptr<juce::AudioFormatReader> reader{ formatManager.createReaderFor(file) })
+            {
+                size_t bytesNeeded = (size_t)reader->numChannels * (size_t)reader->lengthInSamples * sizeof(float);
+                bool fits;
+                {
+                    const juce::ScopedLock sl(lock);
+                    fits = bytesNeeded <= budgetBytes;
+                }
+
+                if (fits && reader->lengthInSamples > 0 && reader->lengthInSamples < std::numeric_limits<int>::max())
+                {
+                    track = std::make_shared<DecodedTrack>();
+                    track->sampleRate = reader->sampleRate;
+                    track->metadataValues = reader->metadataValues;
+                    track->samples.setSize((int)reader->numChannels, (int)reader->lengthInSamples);
+
+                    const int chunk = 1 << 16;
+                    for (juce::int64 pos = 0; pos < reader->lengthInSamples && track != nullptr; pos += chunk)
+                    {
+                        // a chunk that fails to read would be cached as silence, and served for as long as the file is unchanged
+                        if (shuttingDown
+                            || !reader->read(&track->samples, (int)pos, (int)juce::jmin((juce::int64)chunk, reader->lengthInSamples - pos), pos, true, true))
+                            track.reset();
+                    }
+                }
+            }
+
+            if (track != nullptr)
+                insert(file, std::move(track));
+
+            const juce::ScopedLock sl(lock);
+            pending.erase(key);
+        });
+}
+
+void DecodedTrackCache::insert(const juce::File& file, std::shared_ptr<const DecodedTrack> track)
+{
+    auto key = makeKey(file);
+    size_t size = track->getSizeInBytes();
+    const juce::ScopedLock sl(lock);
+
+    if (size > budgetBytes || index.count(key) > 0)
+        return;
+
+    evictToFit(size);
+    entries.push_front({ key, std::move(track) });
+    index[key] = entries.begin();
+    bytesUsed += size;
+}
+
+void DecodedTrackCache::evictToFit(size_t bytesNeeded)
+{
+    // decks still playing an evicted track keep it alive through their shared_ptr
+    while (!entries.empty() && bytesUsed + bytesNeeded > budgetBytes)
+    {
+        auto& oldest = entries.back();
+        bytesUsed -= oldest.track->getSizeInBytes();
+        index.erase(oldest.key);
+        entries.pop_back();
+        ++evictions;
+    }
+}
+
+void DecodedTrackCache::setMemoryBudget(size_t bytes)
+{
+    const juce::ScopedLock sl(lock);
+    budgetBytes = bytes;
+    evictToFit(0);
+}
+
+void DecodedTrackCache::clear()
+{
+    const juce::ScopedLock sl(lock);
+    entries.clear();
+    index.clear();
+    bytesUsed = 0;
+}
+
+DecodedTrackCache::Stats DecodedTrackCache::getStats() const
+{
+    const juce::ScopedLock sl(lock);
+
+    Stats stats;
+    stats.hits = hits;
+    stats.misses = misses;
+    stats.evictions = evictions;
+    stats.bytesUsed = bytesUsed;
+    stats.budgetBytes = budgetBytes;
+    stats.numEntries = (int)entries.size();
+    return stats;
+}
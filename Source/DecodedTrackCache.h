@@ -0,0 +1,97 @@
+/*
+  ==============================================================================
+
+    DecodedTrackCache.h
+    Created: 17 Oct 2026 1:31:55pm
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <list>
+#include <unordered_map>
+#include <unordered_set>
+
+// A whole track decoded to float PCM
+struct DecodedTrack
+{
+    juce::AudioBuffer<float> samples;
+    double sampleRate = 0.0;
+    juce::StringPairArray metadataValues;
+
+    size_t getSizeInBytes() const
+    {
+        return (size_t)samples.getNumChannels() * (size_t)samples.getNumSamples() * sizeof(float);
+    }
+};
+
+// Serves a DecodedTrack through the normal reader interface, so AudioFormatReaderSource
+// (looping, positioning) works unchanged on cached audio.
+class DecodedTrackReader : public juce::AudioFormatReader
+{
+public:
+    explicit DecodedTrackReader(std::shared_ptr<const DecodedTrack> track);
+
+    bool readSamples(int* const* destChannels, int numDestChannels, int startOffsetInDestBuffer,
+        juce::int64 startSampleInFile, int numSamples) override;
+
+private:
+    std::shared_ptr<const DecodedTrack> track;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DecodedTrackReader)
+};
+
+// Process-wide LRU cache of decoded tracks, bounded by a byte budget.
+// Share it with juce::SharedResourcePointer<DecodedTrackCache>.
+class DecodedTrackCache
+{
+public:
+    struct Stats
+    {
+        juce::int64 hits = 0;
+        juce::int64 misses = 0;
+        juce::int64 evictions = 0;
+        size_t bytesUsed = 0;
+        size_t budgetBytes = 0;
+        int numEntries = 0;
+    };
+
+    DecodedTrackCache();
+    ~DecodedTrackCache();
+
+    // Returns the cached track (and marks it most recently used), or nullptr on a miss
+    std::shared_ptr<const DecodedTrack> find(const juce::File& file);
+
+    // Decodes the file on the cache's worker thread and inserts it when done
+    void decodeInBackground(const juce::File& file);
+
+    void insert(const juce::File& file, std::shared_ptr<const DecodedTrack> track);
+    void setMemoryBudget(size_t bytes);
+    void clear();
+    Stats getStats() const;
+
+private:
+    struct Entry
+    {
+        std::string key;
+        std::shared_ptr<const DecodedTrack> track;
+    };
+
+    static std::string makeKey(const juce::File& file);
+    void evictToFit(size_t bytesNeeded);
+
+    juce::CriticalSection lock;
+    std::list<Entry> entries;  // front = most recently used
+    std::unordered_map<std::string, std::list<Entry>::iterator> index;
+    std::unordered_set<std::string> pending;
+    size_t budgetBytes = (size_t)512 * 1024 * 1024;
+    size_t bytesUsed = 0;
+    juce::int64 hits = 0, misses = 0, evictions = 0;
+    std::atomic<bool> shuttingDown{ false };
+
+    juce::AudioFormatManager formatManager;
+    juce::ThreadPool decodePool{ 1 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DecodedTrackCache)
+};
@@ -0,0 +1,185 @@
+/*
+  ==============================================================================
+
+    EngineScript.cpp
+    Created: 18 Oct 2026 3:58:03am
+
+  ==============================================================================
+*/
+
+#include "EngineScript.h"
+#include <iostream>
+
+namespace
+{
+    bool parseSwitch(const juce::String& word, bool& result)
+    {
+        if (word == "on" || word == "1" || word == "true")
+            result = true;
+        else if (word == "off" || word == "0" || word == "false")
+            result = false;
+        else
+            return false;
+
+        return true;
+    }
+}
+
+EngineScript::EngineScript(AudioEngine& e, juce::AudioFormatWriter* w)
+    : engine(e), writer(w)
+{
+}
+
+PlayerAudio* EngineScript::getSelectedDeck()
+{
+    while (engine.getNumDecks() <= selectedDeck)
+        if (engine.addDeck() == nullptr)
+            return nullptr;
+
+    return &engine.getDeck(selectedDeck);
+}
+
+juce::String EngineScript::run(double seconds, bool untilStopped)
+{
+    // offline, time only passes as fast as it is rendered
+    if (!engine.isDeviceOpen())
+    {
+        const double sampleRate = engine.getOfflineSampleRate();
+        const auto limit = seconds > 0.0 ? (juce::int64)(seconds * sampleRate) : std::numeric_limits<juce::int64>::max();
+        const auto step = untilStopped ? (juce::int64)(0.01 * sampleRate) : limit;
+
+        for (juce::int64 done = 0; done < limit; done += step)
+        {
+            if (!engine.renderOffline(juce::jmin(step, limit - done), writer))
+                return "Writing the output file failed";
+
+            if (untilStopped && !engine.isAnyDeckPlaying())
+                break;
+        }
+
+        return {};
+    }
+
+    const auto endTime = juce::Time::getMillisecondCounterHiRes() + seconds * 1000.0;
+
+    while (seconds <= 0.0 || juce::Time::getMillisecondCounterHiRes() < endTime)
+    {
+        if (untilStopped && !engine.isAnyDeckPlaying())
+            break;
+
+        juce::Thread::sleep(10);
+    }
+
+    return {};
+}
+
+juce::String EngineScript::execute(const juce::String& line)
+{
+    auto text = line.upToFirstOccurrenceOf("#", false, false).trim();
+    if (text.isEmpty())
+        return {};
+
+    auto words = juce::StringArray::fromTokens(text, true);
+    const auto command = words[0].toLowerCase();
+    const auto argument = text.fromFirstOccurrenceOf(" ", false, false).trim().unquoted();
+    const double value = words[1].getDoubleValue();
+
+    if (command == "quit" || command == "exit")
+    {
+        quitRequested = true;
+        return {};
+    }
+
+    if (command == "deck")
+    {
+        if (value < 1.0 || value > DeckMixer::maxDecks)
+            return "Deck must be between 1 and " + juce::String(DeckMixer::maxDecks);
+
+        selectedDeck = (int)value - 1;
+        return getSelectedDeck() != nullptr ? juce::String() : juce::String("No free mixer slot");
+    }
+
+    if (command == "threads")
+    {
+        engine.getMixer().setRenderThreads(juce::jlimit(0, 16, (int)value));
+        return {};
+    }
+
+    if (command == "wait")
+        return value > 0.0 ? run(value, false) : juce::String("wait needs a length in seconds");
+
+    if (command == "wait-stopped")
+        return run(value, true);
+
+    if (command == "stats")
+    {
+        std::cout << CallbackStats::createReport(engine.getMixer().getCallbackStats().getSnapshot()) << std::flush;
+        return {};
+    }
+
+    auto* deck = getSelectedDeck();
+    if (deck == nullptr)
+        return "No free mixer slot";
+
+    bool enabled = false;
+
+    if (command == "load")
+        return deck->LoadFile(juce::File::getCurrentWorkingDirectory().getChildFile(argument))
+            ? juce::String() : "Could not open " + argument;
+    if (command == "play")
+        deck->play();
+    else if (command == "stop")
+        deck->stop();
+    else if (command == "restart")
+        deck->Restart();
+    else if (command == "seek")
+        deck->setPosition(value);
+    else if (command == "rate")
+    {
+        if (value <= 0.0 || value > 3.0)
+            return "Rate must be above 0 and at most 3";
+        deck->setPlaybackRate((float)value);
+    }
+    else if (command == "nudge")
+        deck->setNudge(value);
+    else if (command == "gain")
+        deck->setGain((float)value);
+    else if (command == "pan")
+        deck->setPan(juce::jlimit(0.0, 1.0, value));
+    else if (command == "mute")
+        deck->mute();
+    else if (command == "unmute")
+        deck->unmute();
+    else if (command == "loop-a")
+        deck->setLoopPointA(value);
+    else if (command == "loop-b")
+        deck->setLoopPointB(value);
+    else if (command == "keylock" || command == "loop" || command == "segment")
+    {
+        if (!parseSwitch(words[1].toLowerCase(), enabled))
+            return command + " needs on or off";
+
+        if (command == "keylock")
+            deck->setKeyLockEnabled(enabled);
+        else if (command == "loop")
+            deck->setLooping(enabled);
+        else
+            deck->enableSegmentLoop(enabled);
+    }
+    else if (command == "resampler")
+    {
+        const auto name = words[1].toLowerCase();
+        if (name == "linear")
+            deck->setResamplerQuality(ResamplerQuality::linear);
+        else if (name == "cubic")
+            deck->setResamplerQuality(ResamplerQuality::cubic);
+        else if (name == "sinc")
+            deck->setResamplerQuality(ResamplerQuality::sinc);
+        else
+            return "resampler needs linear, cubic or sinc";
+    }
+    else
+        return "Unknown command: " + command;
+
+    return {};
+}
@@ -0,0 +1,48 @@
+/*
+  ==============================================================================
+
+    EngineScript.h
+    Created: 18 Oct 2026 3:58:03am
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "AudioEngine.h"
+
+// Drives an AudioEngine from text commands, one per line, read from a script
+// file or typed on stdin. Commands act on the selected deck:
+//
+//   deck <n>                select deck n (from 1), adding decks as needed
+//   load <file>             play/stop/restart       seek <seconds>
+//   rate <ratio>            nudge <amount>          keylock on|off
+//   gain <gain>             pan <0..1>              mute / unmute
+//   loop on|off             loop-a <s> / loop-b <s> segment on|off
+//   resampler linear|cubic|sinc
+//   threads <n>             render threads for the mixer, 0 for none
+//   wait <seconds>          let the engine run; offline this renders the audio
+//   wait-stopped [max]      run until no deck is playing, or for at most max seconds
+//   stats                   print the callback timing report
+//   quit
+//
+// Blank lines and anything after '#' are ignored.
+class EngineScript
+{
+public:
+    // writer is null when rendering to the null device; unused for device output
+    EngineScript(AudioEngine& engine, juce::AudioFormatWriter* writer);
+
+    // Returns an error, or an empty string
+    juce::String execute(const juce::String& line);
+    bool hasQuit() const { return quitRequested; }
+
+private:
+    PlayerAudio* getSelectedDeck();
+    juce::String run(double seconds, bool untilStopped);
+
+    AudioEngine& engine;
+    juce::AudioFormatWriter* writer;
+    int selectedDeck = 0;
+    bool quitRequested = false;
+};
@@ -0,0 +1,140 @@
+/*
+  ==============================================================================
+
+    GainPanStage.cpp
+    Created: 17 Oct 2026 11:40:52pm
+
+  ==============================================================================
+*/
+
+#include "GainPanStage.h"
+#include "SimdOps.h"
+
+namespace
+{
+    constexpr double smoothingSeconds = 0.02;
+}
+
+GainPanStage::GainPanStage()
+{
+    // unity gain, centred
+    getPanGains(0.5, target[leftLane], target[rightLane]);
+    target[gainLane] = 1.0f;
+    current = target;
+}
+
+void GainPanStage::prepare(double sampleRate)
+{
+    smoothingLength = juce::jmax(1, juce::roundToInt(smoothingSeconds * (sampleRate > 0.0 ? sampleRate : 44100.0)));
+
+    // a glide in progress would otherwise keep the old rate's step
+    current = target;
+    rampRemaining = 0;
+}
+
+void GainPanStage::getPanGains(double pan, float& left, float& right)
+{
+    const double angle = juce::jlimit(0.0, 1.0, pan) * juce::MathConstants<double>::halfPi;
+    left = (float)std::cos(angle);
+    right = (float)std::sin(angle);
+}
+
+void GainPanStage::setTargets(float gain, double pan)
+{
+    std::array<float, numLanes> newTarget{};
+    getPanGains(pan, newTarget[leftLane], newTarget[rightLane]);
+    newTarget[leftLane] *= gain;
+    newTarget[rightLane] *= gain;
+    newTarget[gainLane] = gain;
+
+    if (newTarget == target)
+        return;
+
+    // glide from wherever the previous glide has got to
+    target = newTarget;
+    rampRemaining = smoothingLength;
+    for (int lane = 0; lane < numLanes; ++lane)
+        step[(size_t)lane] = (target[(size_t)lane] - current[(size_t)lane]) / (float)smoothingLength;
+}
+
+GainPanStage::Lane GainPanStage::getLane(int channel, int numChannels)
+{
+    if (numChannels < 2 || channel > 1)
+        return gainLane;
+    return channel == 0 ? leftLane : rightLane;
+}
+
+void GainPanStage::applyRamp(float* data, int numSamples, float start, float rampStep)
+{
+    int i = 0;
+
+   #if MELODYMIX_SIMD_AVAILABLE
+    using namespace simd;
+    Vec gains = add(splat(start), mul(splat(rampStep), set(0.0f, 1.0f, 2.0f, 3.0f)));
+    const Vec advance = splat(rampStep * (float)width);
+
+    for (; i + width <= numSamples; i += width)
+    {
+        store(data + i, mul(load(data + i), gains));
+        gains = add(gains, advance);
+    }
+   #endif
+
+    for (; i < numSamples; ++i)
+        data[i] *= start + rampStep * (float)i;
+}
+
+void GainPanStage::applyConstant(float* data, int numSamples, float gain)
+{
+    if (numSamples <= 0 || gain == 1.0f)
+        return;
+
+    if (gain == 0.0f)
+    {
+        juce::FloatVectorOperations::clear(data, numSamples);
+        return;
+    }
+
+    int i = 0;
+
+   #if MELODYMIX_SIMD_AVAILABLE
+    using namespace simd;
+    const Vec gains = splat(gain);
+    for (; i + width <= numSamples; i += width)
+        store(data + i, mul(load(data + i), gains));
+   #endif
+
+    for (; i < numSamples; ++i)
+        data[i] *= gain;
+}
+
+void GainPanStage::process(juce::AudioBuffer<float>& buffer, int startSample, int numSamples)
+{
+    const int numChannels = buffer.getNumChannels();
+    const int rampSamples = juce::jmin(numSamples, rampRemaining);
+
+    for (int chan = 0; chan < numChannels; ++chan)
+    {
+        const auto lane = (size_t)getLane(chan, numChannels);
+        auto* data = buffer.getWritePointer(chan, startSample);
+
+        if (rampSamples > 0)
+            applyRamp(data, rampSamples, current[lane] + step[lane], step[lane]);
+
+        // the rest of the block sits at the target once the glide has ended
+        if (rampSamples == rampRemaining)
+            applyConstant(data + rampSamples, numSamples - rampSamples, target[lane]);
+    }
+
+    rampRemaining -= rampSamples;
+
+    if (rampRemaining == 0)
+    {
+        current = target;
+    }
+    else
+    {
+        for (int lane = 0; lane < numLanes; ++lane)
+            current[(size_t)lane] += step[(size_t)lane] * (float)rampSamples;
+    }
+}
@@ -0,0 +1,44 @@
+/*
+  ==============================================================================
+
+    GainPanStage.h
+    Created: 17 Oct 2026 11:40:52pm
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// The last stage of a deck's render path: gain, mute and constant-power pan folded
+// into one multiply per sample, in a single vectorised pass over each channel.
+// New values glide linearly over 20 ms, so slider moves do not zipper.
+// Audio thread only, apart from prepare().
+class GainPanStage
+{
+public:
+    GainPanStage();
+
+    void prepare(double sampleRate);
+    // pan: 0 = hard left, 0.5 = centre with both sides at -3 dB, 1 = hard right
+    void setTargets(float gain, double pan);
+    void process(juce::AudioBuffer<float>& buffer, int startSample, int numSamples);
+    // Muted, or turned all the way down, and done gliding there
+    bool isSilent() const { return rampRemaining == 0 && target[gainLane] == 0.0f; }
+
+    static void getPanGains(double pan, float& left, float& right);
+
+private:
+    // channel 0 takes the left lane and channel 1 the right; mono and any extra channels take plain gain
+    enum Lane { leftLane, rightLane, gainLane, numLanes };
+
+    static Lane getLane(int channel, int numChannels);
+    static void applyRamp(float* data, int numSamples, float start, float step);
+    static void applyConstant(float* data, int numSamples, float gain);
+
+    int smoothingLength = 882;
+    int rampRemaining = 0;
+    std::array<float, numLanes> current{}, target{}, step{};
+
+    JUCE_LEAK_DETECTOR(GainPanStage)
+};
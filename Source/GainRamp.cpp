@@ -0,0 +1,73 @@
+/*
+  ==============================================================================
+
+    GainRamp.cpp
+    Created: 17 Oct 2026 11:02:19pm
+
+  ==============================================================================
+*/
+
+#include "GainRamp.h"
+
+void GainRamp::prepare(double newSampleRate)
+{
+    sampleRate = newSampleRate > 0.0 ? newSampleRate : 44100.0;
+}
+
+void GainRamp::setShape(double seconds, CrossfadeCurve newCurve)
+{
+    fadeSeconds = juce::jmax(0.0, seconds);
+    curve = newCurve;
+}
+
+void GainRamp::startFade(int newDirection)
+{
+    // at least one sample per fade, so a zero length is a clean cut rather than a divide by zero
+    step = (float)(1.0 / juce::jmax(1.0, fadeSeconds * sampleRate));
+    direction = newDirection;
+}
+
+void GainRamp::fadeIn()
+{
+    if (progress < 1.0f)
+        startFade(1);
+}
+
+void GainRamp::fadeOut()
+{
+    if (progress > 0.0f)
+        startFade(-1);
+}
+
+void GainRamp::fadeInFromSilence()
+{
+    progress = 0.0f;
+    startFade(1);
+}
+
+void GainRamp::process(juce::AudioBuffer<float>& buffer, int startSample, int numSamples)
+{
+    const int numChannels = buffer.getNumChannels();
+    auto* const* channels = buffer.getArrayOfWritePointers();
+    int i = 0;
+
+    for (; i < numSamples && direction != 0; ++i)
+    {
+        progress += step * (float)direction;
+
+        if (progress >= 1.0f || progress <= 0.0f)
+        {
+            progress = juce::jlimit(0.0f, 1.0f, progress);
+            direction = 0;
+        }
+
+        const float gain = getFadeCurveGain(curve, progress);
+        for (int chan = 0; chan < numChannels; ++chan)
+            channels[chan][startSample + i] *= gain;
+    }
+
+    // whatever follows a finished fade-out stays silent
+    if (progress <= 0.0f && i < numSamples)
+        for (int chan = 0; chan < numChannels; ++chan)
+            buffer.clear(chan, startSample + i, numSamples - i);
+}
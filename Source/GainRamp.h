@@ -0,0 +1,63 @@
+/*
+  ==============================================================================
+
+    GainRamp.h
+    Created: 17 Oct 2026 11:02:19pm
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+enum class CrossfadeCurve
+{
+    linear,
+    equalPower,
+    sCurve
+};
+
+// Fade-in gain at t (0 to 1) along the curve; the matching fade-out is the same curve at 1 - t
+inline float getFadeCurveGain(CrossfadeCurve curve, float t)
+{
+    switch (curve)
+    {
+    case CrossfadeCurve::linear:     return t;
+    case CrossfadeCurve::equalPower: return std::sin(t * juce::MathConstants<float>::halfPi);
+    case CrossfadeCurve::sCurve:
+    default:                         return t * t * (3.0f - 2.0f * t);
+    }
+}
+
+// Per-sample transport fade at the end of a deck's render path: the deck starts by
+// fading in from silence and stops once a fade-out has reached it. Reversing a fade
+// halfway carries on from the current level. Audio thread only, apart from prepare().
+class GainRamp
+{
+public:
+    void prepare(double newSampleRate);
+    // Used by the next fade; a fade already running keeps its speed until it ends
+    void setShape(double seconds, CrossfadeCurve newCurve);
+
+    void fadeIn();
+    void fadeOut();
+    // Drops to silence and fades in from there, e.g. after a jump
+    void fadeInFromSilence();
+
+    bool isSilent() const { return direction == 0 && progress <= 0.0f; }
+    bool isFadingOut() const { return direction < 0; }
+
+    void process(juce::AudioBuffer<float>& buffer, int startSample, int numSamples);
+
+private:
+    void startFade(int newDirection);
+
+    double sampleRate = 44100.0;
+    double fadeSeconds = 0.05;
+    CrossfadeCurve curve = CrossfadeCurve::sCurve;
+    float progress = 0.0f;  // position along the curve: 0 = silent, 1 = full level
+    float step = 0.0f;
+    int direction = 0;
+
+    JUCE_LEAK_DETECTOR(GainRamp)
+};
@@ -0,0 +1,242 @@
+/*
+  ==============================================================================
+
+    GaplessSourceChain.cpp
+    Created: 17 Oct 2026 3:57:08pm
+
+  ==============================================================================
+*/
+
+#include "GaplessSourceChain.h"
+
+namespace
+{
+    void getCrossfadeGains(CrossfadeCurve curve, float t, float& gainIn, float& gainOut)
+    {
+        gainIn = getFadeCurveGain(curve, t);
+        gainOut = getFadeCurveGain(curve, 1.0f - t);
+    }
+}
+
+GaplessSourceChain::GaplessSourceChain(juce::AsyncUpdater& notifier)
+    : switchNotifier(notifier)
+{
+}
+
+void GaplessSourceChain::setCurrentTrack(LoadedTrack* track)
+{
+    current = track;
+    outgoing = nullptr;
+    fadeLength = 0;
+    fadeNowRequested = false;
+
+    if (track != nullptr && preparedSampleRate > 0.0)
+        track->getPlaybackSource()->prepareToPlay(preparedBlockSize, preparedSampleRate);
+}
+
+LoadedTrack* GaplessSourceChain::queueNextTrack(LoadedTrack* track)
+{
+    // a request to fade into the previous queue entry does not carry over
+    fadeNowRequested = false;
+
+    // prime before publishing, so the audio thread only ever sees a ready source
+    if (track != nullptr && preparedSampleRate > 0.0)
+    {
+        track->getPlaybackSource()->setNextReadPosition(0);
+        track->getPlaybackSource()->prepareToPlay(preparedBlockSize, preparedSampleRate);
+    }
+
+    return next.exchange(track);
+}
+
+void GaplessSourceChain::setCrossfade(double seconds, CrossfadeCurve curve)
+{
+    crossfadeSeconds = juce::jmax(0.0, seconds);
+    crossfadeCurve = curve;
+}
+
+void GaplessSourceChain::prepareToPlay(int samplesPerBlockExpected, double sampleRate)
+{
+    preparedBlockSize = samplesPerBlockExpected;
+    preparedSampleRate = sampleRate;
+
+    // the fade mixes in chunks of this size, so any block length works without allocating
+    const int fadeChunk = juce::jmax(samplesPerBlockExpected * 2, 4096);
+    fadeVoice.setSize(2, fadeChunk);
+    fadeGains.setSize(2, fadeChunk);
+
+    for (auto* track : { current.load(), next.load(), outgoing.load() })
+        if (track != nullptr)
+            track->getPlaybackSource()->prepareToPlay(samplesPerBlockExpected, sampleRate);
+}
+
+void GaplessSourceChain::releaseResources()
+{
+    preparedSampleRate = 0.0;
+
+    for (auto* track : { current.load(), next.load(), outgoing.load() })
+        if (track != nullptr)
+            track->getPlaybackSource()->releaseResources();
+}
+
+bool GaplessSourceChain::beginHandOver(LoadedTrack* outgoingTrack, LoadedTrack* queued, juce::int64 fadeSamples)
+{
+    // everything the message thread needs to adopt the switch is in place before the one step that makes it
+    if (fadeSamples > 0)
+    {
+        fadePosition = 0;
+        fadeLength = fadeSamples;
+        activeCurve = crossfadeCurve.load();
+        outgoing = outgoingTrack;
+    }
+
+    // taking the queue entry is the switch; the message thread may have withdrawn it in the meantime
+    if (!next.compare_exchange_strong(queued, nullptr))
+    {
+        outgoing = nullptr;
+        return false;
+    }
+
+    current = queued;
+    switchNotifier.triggerAsyncUpdate();
+    return true;
+}
+
+void GaplessSourceChain::getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill)
+{
+    auto* track = current.load();
+    if (track == nullptr)
+    {
+        bufferToFill.clearActiveBufferRegion();
+        return;
+    }
+
+    // done here rather than by the deck: the transport's lock keeps the track alive while it renders
+    if (track->prefetcher != nullptr)
+        track->prefetcher->setPlayhead(track->readerSource->getNextReadPosition());
+
+    if (outgoing.load() != nullptr)
+    {
+        renderCrossfade(bufferToFill);
+        return;
+    }
+
+    auto* source = track->getPlaybackSource();
+    auto* queued = next.load();
+
+    if (queued != nullptr)
+    {
+        auto fadeSamples = (juce::int64)(crossfadeSeconds.load() * track->getSampleRate());
+
+        if (fadeNowRequested.exchange(false) && fadeSamples > 0 && beginHandOver(track, queued, fadeSamples))
+        {
+            renderCrossfade(bufferToFill);
+            return;
+        }
+
+        if (!source->isLooping())
+        {
+            auto remaining = source->getTotalLength() - source->getNextReadPosition();
+            fadeSamples = juce::jmin(fadeSamples, juce::jmax((juce::int64)0, remaining));
+
+            // samples still to play before the hand-over point
+            auto lead = remaining - fadeSamples;
+
+            if (lead < bufferToFill.numSamples)
+            {
+                int head = (int)juce::jmax((juce::int64)0, lead);
+                if (head > 0)
+                    source->getNextAudioBlock(juce::AudioSourceChannelInfo(bufferToFill.buffer, bufferToFill.startSample, head));
+
+                juce::AudioSourceChannelInfo rest(bufferToFill.buffer, bufferToFill.startSample + head, bufferToFill.numSamples - head);
+
+                if (!beginHandOver(track, queued, fadeSamples))
+                    source->getNextAudioBlock(rest);
+                else if (fadeSamples > 0)
+                    renderCrossfade(rest);
+                else
+                    queued->getPlaybackSource()->getNextAudioBlock(rest);
+                return;
+            }
+        }
+    }
+
+    source->getNextAudioBlock(bufferToFill);
+}
+
+void GaplessSourceChain::renderCrossfade(const juce::AudioSourceChannelInfo& bufferToFill)
+{
+    auto* incoming = current.load()->getPlaybackSource();
+    auto* fading = outgoing.load()->getPlaybackSource();
+
+    auto* gainIn = fadeGains.getWritePointer(0);
+    auto* gainOut = fadeGains.getWritePointer(1);
+    const int numChannels = juce::jmin(bufferToFill.buffer->getNumChannels(), 2);
+
+    int done = 0;
+    while (done < bufferToFill.numSamples)
+    {
+        const int chunk = juce::jmin(bufferToFill.numSamples - done, fadeVoice.getNumSamples());
+        const int start = bufferToFill.startSample + done;
+
+        incoming->getNextAudioBlock(juce::AudioSourceChannelInfo(bufferToFill.buffer, start, chunk));
+        fading->getNextAudioBlock(juce::AudioSourceChannelInfo(&fadeVoice, 0, chunk));
+
+        for (int i = 0; i < chunk; ++i)
+        {
+            float t = (float)juce::jmin(fadePosition + i, fadeLength) / (float)fadeLength;
+            getCrossfadeGains(activeCurve, t, gainIn[i], gainOut[i]);
+        }
+
+        for (int chan = 0; chan < numChannels; ++chan)
+        {
+            auto* dest = bufferToFill.buffer->getWritePointer(chan, start);
+            juce::FloatVectorOperations::multiply(dest, gainIn, chunk);
+
+            for (int i = 0; i < chunk; ++i)
+                dest[i] += fadeVoice.getSample(chan, i) * gainOut[i];
+        }
+
+        fadePosition += chunk;
+        done += chunk;
+
+        if (fadePosition >= fadeLength)
+        {
+            // fade complete: the outgoing voice is released on the message thread
+            outgoing = nullptr;
+            switchNotifier.triggerAsyncUpdate();
+
+            if (done < bufferToFill.numSamples)
+                incoming->getNextAudioBlock(juce::AudioSourceChannelInfo(bufferToFill.buffer,
+                    bufferToFill.startSample + done, bufferToFill.numSamples - done));
+            return;
+        }
+    }
+}
+
+void GaplessSourceChain::setNextReadPosition(juce::int64 newPosition)
+{
+    if (auto* track = current.load())
+        track->getPlaybackSource()->setNextReadPosition(newPosition);
+}
+
+juce::int64 GaplessSourceChain::getNextReadPosition() const
+{
+    if (auto* track = current.load())
+        return track->getPlaybackSource()->getNextReadPosition();
+    return 0;
+}
+
+juce::int64 GaplessSourceChain::getTotalLength() const
+{
+    if (auto* track = current.load())
+        return track->getPlaybackSource()->getTotalLength();
+    return 0;
+}
+
+bool GaplessSourceChain::isLooping() const
+{
+    if (auto* track = current.load())
+        return track->getPlaybackSource()->isLooping();
+    return false;
+}
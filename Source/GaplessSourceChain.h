@@ -0,0 +1,79 @@
+/*
+  ==============================================================================
+
+    GaplessSourceChain.h
+    Created: 17 Oct 2026 3:57:08pm
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "LoadedTrack.h"
+#include "GainRamp.h"
+
+// The positionable source a deck's transport plays from. It forwards to the
+// current track and, when a next track is queued, hands over to it inside the
+// audio callback: either on the exact sample where the current one runs out
+// (gapless), or by crossfading the two voices over the last N seconds.
+// Position and length always describe the current (incoming) track.
+class GaplessSourceChain : public juce::PositionableAudioSource
+{
+public:
+    // notifier is triggered from the audio thread when a hand-over starts and when a fade ends
+    explicit GaplessSourceChain(juce::AsyncUpdater& notifier);
+
+    // Only call while the chain is detached from the transport; drops any fading-out voice
+    void setCurrentTrack(LoadedTrack* track);
+    LoadedTrack* getCurrentTrack() const { return current.load(); }
+    LoadedTrack* getOutgoingTrack() const { return outgoing.load(); }
+
+    // The track's sources are prepared here if the chain is; nullptr clears the queue.
+    // Returns the previously queued track if the audio thread had not taken it yet.
+    // Once it has been taken, the hand-over has happened: getOutgoingTrack() already
+    // reflects it, though getCurrentTrack() may lag for a moment.
+    LoadedTrack* queueNextTrack(LoadedTrack* track);
+    bool hasQueuedTrack() const { return next.load() != nullptr; }
+
+    // A length of zero means plain gapless hand-over
+    void setCrossfade(double seconds, CrossfadeCurve curve);
+    double getCrossfadeSeconds() const { return crossfadeSeconds.load(); }
+    CrossfadeCurve getCrossfadeCurve() const { return crossfadeCurve.load(); }
+
+    // Starts fading into the queued track at the next block instead of waiting for the end
+    void startCrossfadeNow() { fadeNowRequested = true; }
+
+    void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
+    void releaseResources() override;
+    void getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill) override;
+
+    void setNextReadPosition(juce::int64 newPosition) override;
+    juce::int64 getNextReadPosition() const override;
+    juce::int64 getTotalLength() const override;
+    bool isLooping() const override;
+
+private:
+    bool beginHandOver(LoadedTrack* outgoingTrack, LoadedTrack* queued, juce::int64 fadeSamples);
+    void renderCrossfade(const juce::AudioSourceChannelInfo& bufferToFill);
+
+    juce::AsyncUpdater& switchNotifier;
+    std::atomic<LoadedTrack*> current{ nullptr };
+    std::atomic<LoadedTrack*> next{ nullptr };
+    std::atomic<LoadedTrack*> outgoing{ nullptr };
+    int preparedBlockSize = 0;
+    double preparedSampleRate = 0.0;
+
+    std::atomic<double> crossfadeSeconds{ 0.0 };
+    std::atomic<CrossfadeCurve> crossfadeCurve{ CrossfadeCurve::equalPower };
+    std::atomic<bool> fadeNowRequested{ false };
+
+    // audio-thread state for the fade in progress
+    // kept stereo: a reader only copies a mono source into the right channel of a buffer of at most two
+    juce::AudioBuffer<float> fadeVoice;
+    juce::AudioBuffer<float> fadeGains;  // incoming, outgoing
+    juce::int64 fadePosition = 0;
+    juce::int64 fadeLength = 0;
+    CrossfadeCurve activeCurve = CrossfadeCurve::equalPower;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(GaplessSourceChain)
+};
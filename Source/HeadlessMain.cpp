@@ -0,0 +1,156 @@
+/*
+  ==============================================================================
+
+    HeadlessMain.cpp
+    Created: 18 Oct 2026 4:14:37am
+
+    Entry point of the console player (Headless/AudioPlayerCli.jucer):
+
+      AudioPlayerCli [--script=<file>] [--output=null|device|<file.wav|file.flac>]
+                     [--rate=<Hz>] [--block=<samples>] [--bits=<16|24|32>]
+
+    Commands come from the script, or from stdin without one; see EngineScript.h.
+    The default output is the null device, which renders offline as fast as the
+    CPU allows and discards the audio.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "AudioEngine.h"
+#include "EngineScript.h"
+#include <iostream>
+
+namespace
+{
+    std::unique_ptr<juce::AudioFormatWriter> createWriter(const juce::File& file, double sampleRate, int bitsPerSample)
+    {
+        std::unique_ptr<juce::AudioFormat> format;
+        if (file.hasFileExtension("flac"))
+            format = std::make_unique<juce::FlacAudioFormat>();
+        else
+            format = std::make_unique<juce::WavAudioFormat>();
+
+        file.deleteFile();
+        auto stream = std::make_unique<juce::FileOutputStream>(file);
+        if (stream->failedToOpen())
+            return nullptr;
+
+        std::unique_ptr<juce::AudioFormatWriter> writer(format->createWriterFor(stream.get(), sampleRate, 2,
+            bitsPerSample, {}, 0));
+        if (writer != nullptr)
+            stream.release();  // now owned by the writer
+        return writer;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    // the decks post their change and update messages even though nothing here dispatches them
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::ArgumentList args(argc, argv);
+    const auto output = args.getValueForOption("--output").trim();
+    const double sampleRate = args.containsOption("--rate") ? args.getValueForOption("--rate").getDoubleValue() : 44100.0;
+    const int blockSize = args.containsOption("--block") ? args.getValueForOption("--block").getIntValue() : 512;
+    const int bitsPerSample = args.containsOption("--bits") ? args.getValueForOption("--bits").getIntValue() : 24;
+
+    if (sampleRate <= 0.0 || blockSize <= 0)
+    {
+        std::cerr << "Invalid --rate or --block" << std::endl;
+        return 1;
+    }
+
+    AudioEngine engine;
+    std::unique_ptr<juce::AudioFormatWriter> writer;
+
+    if (output == "device")
+    {
+        auto error = engine.openAudioDevice();
+        if (error.isNotEmpty())
+        {
+            std::cerr << error << std::endl;
+            return 1;
+        }
+    }
+    else
+    {
+        if (output.isNotEmpty() && output != "null")
+        {
+            auto file = juce::File::getCurrentWorkingDirectory().getChildFile(output);
+            writer = createWriter(file, sampleRate, bitsPerSample);
+            if (writer == nullptr)
+            {
+                std::cerr << "Cannot write " << file.getFullPathName() << std::endl;
+                return 1;
+            }
+        }
+
+        engine.prepareOffline(sampleRate, blockSize);
+    }
+
+    EngineScript script(engine, writer.get());
+    std::unique_ptr<juce::InputStream> scriptStream;
+
+    if (args.containsOption("--script"))
+    {
+        auto file = juce::File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption("--script"));
+        scriptStream = file.createInputStream();
+        if (scriptStream == nullptr)
+        {
+            std::cerr << "Cannot read " << file.getFullPathName() << std::endl;
+            return 1;
+        }
+    }
+
+    const auto startTime = juce::Time::getMillisecondCounterHiRes();
+    int lineNumber = 0;
+    int exitCode = 0;
+
+    while (!script.hasQuit())
+    {
+        juce::String line;
+
+        if (scriptStream != nullptr)
+        {
+            if (scriptStream->isExhausted())
+                break;
+            line = scriptStream->readNextLine();
+        }
+        else
+        {
+            std::string input;
+            if (!std::getline(std::cin, input))
+                break;
+            line = juce::String(input);
+        }
+
+        ++lineNumber;
+        auto error = script.execute(line);
+        if (error.isEmpty())
+            continue;
+
+        std::cerr << "line " << lineNumber << ": " << error << std::endl;
+
+        // typing on stdin gets another go; a script stops at its first mistake
+        if (scriptStream != nullptr)
+        {
+            exitCode = 1;
+            break;
+        }
+    }
+
+    writer.reset();
+    engine.closeAudioDevice();
+
+    if (!engine.isDeviceOpen() && engine.getOfflineSampleRate() > 0.0)
+    {
+        const double renderedSeconds = (double)engine.getRenderedSamples() / engine.getOfflineSampleRate();
+        const double wallSeconds = (juce::Time::getMillisecondCounterHiRes() - startTime) / 1000.0;
+        std::cout << "rendered " << juce::String(renderedSeconds, 2) << " s in " << juce::String(wallSeconds, 2)
+            << " s (" << juce::String(renderedSeconds / juce::jmax(1.0e-6, wallSeconds), 1) << "x real time)\n";
+    }
+
+    std::cout << CallbackStats::createReport(engine.getMixer().getCallbackStats().getSnapshot()) << std::flush;
+    return exitCode;
+}
@@ -0,0 +1,298 @@
+/*
+  ==============================================================================
+
+    LibraryIndex.cpp
+    Created: 18 Oct 2026 7:02:51am
+
+  ==============================================================================
+*/
+
+#include "LibraryIndex.h"
+#include "AtomicFile.h"
+
+namespace
+{
+    constexpr int indexMagic = 0x58494c4d;   // "MLIX"
+    constexpr int indexVersion = 1;
+}
+
+TrackInfo TrackInfo::fromReader(const juce::AudioFormatReader& reader)
+{
+    TrackInfo info;
+    info.formatName = reader.getFormatName();
+    info.sampleRate = reader.sampleRate;
+    info.durationSeconds = reader.sampleRate > 0.0 ? (double)reader.lengthInSamples / reader.sampleRate : 0.0;
+    info.numChannels = (int)reader.numChannels;
+    info.tags = reader.metadataValues;
+    return info;
+}
+
+juce::String TrackInfo::getTag(const juce::String& name) const
+{
+    for (auto& key : tags.getAllKeys())
+        if (key.compareIgnoreCase(name) == 0)
+            return tags[key];
+
+    return {};
+}
+
+juce::String TrackInfo::getDisplayName(const juce::File& file) const
+{
+    const auto title = getTag("title");
+    if (title.isEmpty())
+        return file.getFileName();
+
+    auto artist = getTag("artist");
+    if (artist.isEmpty())
+        artist = getTag("author");
+
+    return artist.isNotEmpty() ? artist + " - " + title : title;
+}
+
+LibraryIndex::LibraryIndex()
+    : scanPool(juce::jlimit(1, 4, juce::SystemStats::getNumCpus() / 2), 0, juce::Thread::Priority::low)
+{
+    formatManager.registerBasicFormats();
+    load();
+}
+
+LibraryIndex::~LibraryIndex()
+{
+    shuttingDown = true;
+    scanPool.removeAllJobs(true, 10000);
+    save();
+}
+
+juce::File LibraryIndex::getIndexFile()
+{
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+        .getChildFile("AudioPlayer").getChildFile("LibraryIndex.bin");
+}
+
+bool LibraryIndex::find(const juce::File& file, TrackInfo& info) const
+{
+    const auto fileSize = file.getSize();
+    const auto modified = file.getLastModificationTime().toMilliseconds();
+    const juce::ScopedLock sl(lock);
+
+    auto it = entries->find(makeKey(file));
+    if (it == entries->end() || it->second.fileSize != fileSize || it->second.modified != modified)
+        return false;
+
+    info = it->second.info;
+    return true;
+}
+
+void LibraryIndex::add(const juce::File& file, const TrackInfo& info)
+{
+    store(makeKey(file), { file.getSize(), file.getLastModificationTime().toMilliseconds(), info });
+    sendChangeMessage();
+}
+
+void LibraryIndex::store(const std::string& key, Entry entry)
+{
+    const juce::ScopedLock storing(storeLock);
+    std::shared_ptr<EntryMap> copy;
+
+    {
+        const juce::ScopedLock sl(lock);
+        if (entries.use_count() == 1)
+        {
+            (*entries)[key] = std::move(entry);
+            dirty = true;
+            return;
+        }
+    }
+
+    // a save holds the current map; only writers change it, so it can be copied without lock
+    copy = std::make_shared<EntryMap>(*entries);
+    (*copy)[key] = std::move(entry);
+
+    const juce::ScopedLock sl(lock);
+    entries = std::move(copy);
+    dirty = true;
+}
+
+int LibraryIndex::getNumEntries() const
+{
+    const juce::ScopedLock sl(lock);
+    return (int)entries->size();
+}
+
+void LibraryIndex::scanFiles(const juce::Array<juce::File>& files)
+{
+    TrackInfo existing;
+
+    for (auto& file : files)
+    {
+        if (find(file, existing))
+            continue;
+
+        {
+            const juce::ScopedLock sl(lock);
+            const auto key = makeKey(file);
+            if (unreadable.count(key) > 0 || !pending.insert(key).second)
+                continue;
+        }
+
+        ++pendingJobs;
+        scanPool.addJob([this, file]
+            {
+                scanFile(file);
+                jobFinished();
+            });
+    }
+}
+
+void LibraryIndex::scanFolder(const juce::File& folder, std::function<void(juce::Array<juce::File>)> onFound)
+{
+    ++pendingJobs;
+    scanPool.addJob([this, folder, onFound = std::move(onFound)]
+        {
+            juce::Array<juce::File> found;
+
+            for (auto& entry : juce::RangedDirectoryIterator(folder, true, formatManager.getWildcardForAllFormats(),
+                                                             juce::File::findFiles))
+            {
+                if (shuttingDown)
+                    break;
+                found.add(entry.getFile());
+            }
+
+            found.sort();
+
+            // the index may be gone by the time this runs, so only the callback is captured
+            if (!shuttingDown)
+            {
+                scanFiles(found);
+                juce::MessageManager::callAsync([onFound, found] { onFound(found); });
+            }
+
+            jobFinished();
+        });
+}
+
+void LibraryIndex::scanFile(const juce::File& file)
+{
+    const auto key = makeKey(file);
+
+    if (shuttingDown)
+    {
+        const juce::ScopedLock sl(lock);
+        pending.erase(key);
+        return;
+    }
+
+    const auto fileSize = file.getSize();
+    const auto modified = file.getLastModificationTime().toMilliseconds();
+
+    // each pool thread opens its own reader; the format manager itself is only read
+    std::unique_ptr<juce::AudioFormatReader> reader{ formatManager.createReaderFor(file) };
+    Entry entry{ fileSize, modified, reader != nullptr ? TrackInfo::fromReader(*reader) : TrackInfo() };
+    reader.reset();
+
+    const bool readable = entry.info.sampleRate > 0.0;
+    if (readable)
+        store(key, std::move(entry));
+
+    {
+        const juce::ScopedLock sl(lock);
+        pending.erase(key);
+
+        if (!readable)
+            unreadable.insert(key);
+    }
+
+    sendChangeMessage();
+}
+
+void LibraryIndex::jobFinished()
+{
+    // written once a batch drains rather than after every file
+    if (--pendingJobs == 0 && !shuttingDown)
+        save();
+}
+
+void LibraryIndex::load()
+{
+    auto in = getIndexFile().createInputStream();
+    if (in == nullptr || in->readInt() != indexMagic || in->readInt() != indexVersion)
+        return;
+
+    const int count = in->readInt();
+    EntryMap loaded;
+
+    for (int i = 0; i < count && !in->isExhausted(); ++i)
+    {
+        const auto path = in->readString();
+        Entry entry;
+        entry.fileSize = in->readInt64();
+        entry.modified = in->readInt64();
+        entry.info.formatName = in->readString();
+        entry.info.durationSeconds = in->readDouble();
+        entry.info.sampleRate = in->readDouble();
+        entry.info.numChannels = in->readCompressedInt();
+
+        const int numTags = in->readCompressedInt();
+        for (int tag = 0; tag < numTags && !in->isExhausted(); ++tag)
+        {
+            const auto key = in->readString();
+            entry.info.tags.set(key, in->readString());
+        }
+
+        loaded[path.toStdString()] = std::move(entry);
+    }
+
+    // before any scan has started, so nothing else can be holding the map
+    const juce::ScopedLock sl(lock);
+    *entries = std::move(loaded);
+}
+
+void LibraryIndex::save()
+{
+    // one writer at a time, so an older snapshot never lands after a newer one
+    const juce::ScopedLock writing(saveLock);
+    std::shared_ptr<const EntryMap> snapshot;
+
+    {
+        const juce::ScopedLock sl(lock);
+        if (!dirty)
+            return;
+
+        snapshot = entries;
+        dirty = false;
+    }
+
+    // serialised without the lock, so find() keeps answering the message thread meanwhile
+    juce::MemoryOutputStream data;
+    data.writeInt(indexMagic);
+    data.writeInt(indexVersion);
+    data.writeInt((int)snapshot->size());
+
+    for (auto& [path, entry] : *snapshot)
+    {
+        data.writeString(juce::String::fromUTF8(path.c_str(), (int)path.size()));
+        data.writeInt64(entry.fileSize);
+        data.writeInt64(entry.modified);
+        data.writeString(entry.info.formatName);
+        data.writeDouble(entry.info.durationSeconds);
+        data.writeDouble(entry.info.sampleRate);
+        data.writeCompressedInt(entry.info.numChannels);
+
+        auto& keys = entry.info.tags.getAllKeys();
+        auto& values = entry.info.tags.getAllValues();
+        data.writeCompressedInt(keys.size());
+        for (int tag = 0; tag < keys.size(); ++tag)
+        {
+            data.writeString(keys[tag]);
+            data.writeString(values[tag]);
+        }
+    }
+
+    if (!writeFileAtomically(getIndexFile(), data.getMemoryBlock()))
+    {
+        // try again with the next batch
+        const juce::ScopedLock sl(lock);
+        dirty = true;
+    }
+}
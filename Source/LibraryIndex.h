@@ -0,0 +1,92 @@
+/*
+  ==============================================================================
+
+    LibraryIndex.h
+    Created: 18 Oct 2026 7:02:51am
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <unordered_map>
+#include <unordered_set>
+
+// What the library knows about a track without opening it
+struct TrackInfo
+{
+    juce::String formatName;
+    double durationSeconds = 0.0;
+    double sampleRate = 0.0;
+    int numChannels = 0;
+    juce::StringPairArray tags;  // the reader's metadataValues
+
+    static TrackInfo fromReader(const juce::AudioFormatReader& reader);
+
+    // Case-insensitive; empty if the track has no such tag
+    juce::String getTag(const juce::String& name) const;
+    // "Artist - Title" from the tags, or the file name
+    juce::String getDisplayName(const juce::File& file) const;
+};
+
+// Process-wide index of track metadata, filled by scanning folders and files on a
+// pool of low-priority threads and kept on disk between runs. Entries are keyed by
+// path and only trusted while the file's size and modification time still match,
+// so an edited file is read again. Listeners hear about new entries on the message
+// thread. Share it with juce::SharedResourcePointer<LibraryIndex>.
+class LibraryIndex : public juce::ChangeBroadcaster
+{
+public:
+    LibraryIndex();
+    ~LibraryIndex() override;
+
+    // Any thread; false if the file is not indexed or has changed since
+    bool find(const juce::File& file, TrackInfo& info) const;
+    // Any thread; records a track that was opened anyway, e.g. to play it
+    void add(const juce::File& file, const TrackInfo& info);
+
+    // Reads every file that is not indexed yet in the background
+    void scanFiles(const juce::Array<juce::File>& files);
+    // Walks the folder and its subfolders in the background, indexing every audio file it finds.
+    // onFound then gets the files, sorted, on the message thread.
+    void scanFolder(const juce::File& folder, std::function<void(juce::Array<juce::File>)> onFound);
+
+    int getNumEntries() const;
+    int getNumPending() const { return pendingJobs.load(); }
+
+    static juce::File getIndexFile();
+
+private:
+    struct Entry
+    {
+        juce::int64 fileSize = 0;
+        juce::int64 modified = 0;
+        TrackInfo info;
+    };
+
+    using EntryMap = std::unordered_map<std::string, Entry>;
+
+    static std::string makeKey(const juce::File& file) { return file.getFullPathName().toStdString(); }
+    void store(const std::string& key, Entry entry);
+    void scanFile(const juce::File& file);
+    void jobFinished();
+    void load();
+    void save();
+
+    mutable juce::CriticalSection lock;
+    juce::CriticalSection saveLock;
+    juce::CriticalSection storeLock;  // one writer at a time, so a copy can be made outside lock
+    // Copy-on-write: a save serialises the map it took without holding lock, and while it
+    // does the map is never modified; the next store works on a copy instead
+    std::shared_ptr<EntryMap> entries = std::make_shared<EntryMap>();
+    std::unordered_set<std::string> pending;
+    std::unordered_set<std::string> unreadable;  // this run only, so a rescan does not keep retrying them
+    bool dirty = false;
+    std::atomic<int> pendingJobs{ 0 };
+    std::atomic<bool> shuttingDown{ false };
+
+    juce::AudioFormatManager formatManager;
+    juce::ThreadPool scanPool;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LibraryIndex)
+};
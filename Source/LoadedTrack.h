@@ -0,0 +1,34 @@
+/*
+  ==============================================================================
+
+    LoadedTrack.h
+    Created: 17 Oct 2026 3:57:08pm
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "ReadAheadAudioSource.h"
+#include "MappedTrackPrefetcher.h"
+
+// Everything a deck keeps alive for one opened track. Members are destroyed
+// bottom-up, so the read-ahead wrapper and prefetcher go before the reader they use.
+struct LoadedTrack
+{
+    juce::File file;
+    std::unique_ptr<juce::AudioFormatReaderSource> readerSource;
+    std::unique_ptr<MappedTrackPrefetcher> prefetcher;
+    std::unique_ptr<ReadAheadAudioSource> readAheadSource;
+    bool fromCache = false;
+
+    juce::AudioFormatReader& getReader() const { return *readerSource->getAudioFormatReader(); }
+    double getSampleRate() const { return getReader().sampleRate; }
+
+    juce::PositionableAudioSource* getPlaybackSource() const
+    {
+        if (readAheadSource != nullptr)
+            return readAheadSource.get();
+        return readerSource.get();
+    }
+};
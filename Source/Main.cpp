@@ -7,6 +7,7 @@
     */
     #include <JuceHeader.h>
     #include "MainComponent.h"
+    #include "Benchmarks.h"
 
     // Our application class
     class SimpleAudioPlayer : public juce::JUCEApplication
@@ -15,8 +16,15 @@
         const juce::String getApplicationName() override { return "Simple Audio Player"; }
         const juce::String getApplicationVersion() override { return "1.0"; }
 
-        void initialise(const juce::String&) override
+        void initialise(const juce::String& commandLine) override
         {
+            if (commandLine.contains("--benchmark"))
+            {
+                runBenchmarks(commandLine);
+                quit();
+                return;
+            }
+
             // Create and show the main window
             mainWindow = std::make_unique<MainWindow>(getApplicationName());
         }
@@ -1,41 +1,200 @@
 #include "MainComponent.h"
 #include "PlayerGUI.h"
+#include "StatsPanel.h"
 MainComponent::MainComponent()
 {
-    player1 = std::make_unique<PlayerGUI>("Player1");
-    addAndMakeVisible(player1.get());
-    mixer.addInputSource(&player1->playerAudio, false);
+    addDeckButton.onClick = [this] { addDeck(); };
+    addAndMakeVisible(addDeckButton);
+    removeDeckButton.onClick = [this] { removeLastDeck(); };
+    addAndMakeVisible(removeDeckButton);
+    parallelRenderToggle.onClick = [this]
+        {
+            // one worker per spare core, up to three; the callback thread renders too
+            int workers = juce::jlimit(1, 3, juce::SystemStats::getNumCpus() - 1);
+            engine.getMixer().setRenderThreads(parallelRenderToggle.getToggleState() ? workers : 0);
+        };
+    addAndMakeVisible(parallelRenderToggle);
+    statsButton.onClick = [this] { showStats(); };
+    addAndMakeVisible(statsButton);
+    exportButton.onClick = [this]
+        {
+            if (exporter.isExporting())
+                exporter.cancel();
+            else
+                chooseExportFile();
+        };
+    addAndMakeVisible(exportButton);
+    addChildComponent(exportProgressBar);
 
-    player2 = std::make_unique<PlayerGUI>("Player2");
-    mixer.addInputSource(&player2->playerAudio, false);
-    addAndMakeVisible(player2.get());
+    addDeck();
+    addDeck();
 
-    setSize(500, 400);
-    setAudioChannels(0, 2);
+    setSize(500, 430);
+
+    auto error = engine.openAudioDevice();
+    if (error.isNotEmpty())
+        juce::AlertWindow::showMessageBoxAsync(juce::MessageBoxIconType::WarningIcon, "Audio device", error);
 }
 
 
 MainComponent::~MainComponent()
 {
-    if (player1) player1->saveLastSession();
-    if (player2) player2->saveLastSession();
-    shutdownAudio();
+    if (statsWindow != nullptr)
+        delete statsWindow.getComponent();
+    exporter.cancel();
+    engine.closeAudioDevice();
+}
+
+void MainComponent::addDeck()
+{
+    if (decks.size() >= maxVisibleDecks)
+        return;
+
+    auto* audio = engine.addDeck();
+    if (audio == nullptr)
+        return;
+
+    auto* deck = decks.add(std::make_unique<PlayerGUI>(*audio, "Player" + juce::String(decks.size() + 1)));
+    addAndMakeVisible(deck);
+
+    updateDeckButtons();
+    resized();
 }
 
+void MainComponent::removeLastDeck()
+{
+    if (decks.size() <= 1)
+        return;
+
+    // the GUI records its deck's session as it goes away, so it goes before the deck
+    decks.removeLast();
+    engine.removeLastDeck();
+
+    updateDeckButtons();
+    resized();
+}
 
-void MainComponent::prepareToPlay(int samplesPerBlockExpected, double sampleRate)
+void MainComponent::showStats()
 {
-    mixer.prepareToPlay(samplesPerBlockExpected, sampleRate);
+    if (statsWindow != nullptr)
+    {
+        statsWindow->toFront(true);
+        return;
+    }
+
+    juce::DialogWindow::LaunchOptions options;
+    options.content.setOwned(new StatsPanel(engine.getMixer(), engine.getDeviceManager()));
+    options.dialogTitle = "Audio engine stats";
+    options.dialogBackgroundColour = juce::Colours::darkgrey;
+    options.escapeKeyTriggersCloseButton = true;
+    options.resizable = true;
+    statsWindow = options.launchAsync();
 }
 
-void MainComponent::getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill)
+void MainComponent::chooseExportFile()
 {
-    mixer.getNextAudioBlock(bufferToFill);
+    fileChooser = std::make_unique<juce::FileChooser>("Export the mix as...",
+        juce::File::getSpecialLocation(juce::File::userMusicDirectory).getChildFile("mix.wav"), "*.wav;*.flac");
+
+    fileChooser->launchAsync(
+        juce::FileBrowserComponent::saveMode |
+        juce::FileBrowserComponent::canSelectFiles |
+        juce::FileBrowserComponent::warnAboutOverwriting,
+        [this](const juce::FileChooser& fc)
+        {
+            auto file = fc.getResult();
+            if (file == juce::File())
+                return;
+
+            if (!file.hasFileExtension("wav;flac"))
+                file = file.withFileExtension("wav");
+
+            // a looping deck never ends by itself, so the mix needs a length
+            bool anyLooping = false;
+            for (auto* deck : decks)
+                anyLooping = anyLooping || deck->playerAudio.isLooping() || deck->playerAudio.getSegmentLooping();
+
+            if (anyLooping)
+                askExportLength(file);
+            else
+                startExport(file, 0.0);
+        });
 }
 
-void MainComponent::releaseResources()
+void MainComponent::askExportLength(const juce::File& file)
 {
-    mixer.releaseResources();
+    exportLengthPrompt = std::make_unique<juce::AlertWindow>("Export length",
+        "A deck is looping, so the mix has no natural end. How many seconds should be exported?",
+        juce::MessageBoxIconType::QuestionIcon, this);
+    exportLengthPrompt->addTextEditor("seconds", "300");
+    exportLengthPrompt->addButton("Export", 1, juce::KeyPress(juce::KeyPress::returnKey));
+    exportLengthPrompt->addButton("Cancel", 0, juce::KeyPress(juce::KeyPress::escapeKey));
+
+    exportLengthPrompt->enterModalState(true, juce::ModalCallbackFunction::create([this, file](int result)
+        {
+            auto seconds = exportLengthPrompt->getTextEditorContents("seconds").getDoubleValue();
+            exportLengthPrompt.reset();
+
+            if (result == 1 && seconds > 0.0)
+                startExport(file, seconds);
+        }));
+}
+
+void MainComponent::startExport(const juce::File& file, double lengthSeconds)
+{
+    MixdownExporter::Options options;
+    options.file = file;
+    options.format = MixdownExporter::getFormatForFile(file);
+    options.lengthSeconds = lengthSeconds;
+    options.renderThreads = engine.getMixer().getRenderThreads();
+
+    if (engine.isDeviceOpen())
+        options.sampleRate = engine.getDeviceSampleRate();
+
+    juce::Array<PlayerAudio*> sources;
+    for (auto* deck : decks)
+        sources.add(&deck->playerAudio);
+
+    auto error = exporter.start(sources, options, [this](bool succeeded, const juce::String& message)
+        {
+            exportFinished(succeeded, message);
+        });
+
+    if (error.isNotEmpty())
+    {
+        juce::AlertWindow::showMessageBoxAsync(juce::MessageBoxIconType::WarningIcon, "Export", error);
+        return;
+    }
+
+    exportProgress = 0.0;
+    exportButton.setButtonText("Cancel");
+    parallelRenderToggle.setVisible(false);
+    exportProgressBar.setVisible(true);
+    startTimer(100);
+}
+
+void MainComponent::exportFinished(bool succeeded, const juce::String& message)
+{
+    stopTimer();
+    exportButton.setButtonText("Export");
+    exportProgressBar.setVisible(false);
+    parallelRenderToggle.setVisible(true);
+
+    if (succeeded)
+        juce::AlertWindow::showMessageBoxAsync(juce::MessageBoxIconType::InfoIcon, "Export", "The mix has been exported");
+    else
+        juce::AlertWindow::showMessageBoxAsync(juce::MessageBoxIconType::WarningIcon, "Export", message);
+}
+
+void MainComponent::timerCallback()
+{
+    exportProgress = exporter.getProgress();
+}
+
+void MainComponent::updateDeckButtons()
+{
+    addDeckButton.setEnabled(decks.size() < maxVisibleDecks);
+    removeDeckButton.setEnabled(decks.size() > 1);
 }
 
 void MainComponent::paint(juce::Graphics& g)
@@ -45,8 +204,30 @@ void MainComponent::paint(juce::Graphics& g)
 
 void MainComponent::resized()
 {
-    player1->setBounds(0, 0, getWidth(), getHeight() / 2);
-    player2->setBounds(0, getHeight() / 2, getWidth(), getHeight() / 2);
+    auto area = getLocalBounds();
+    auto buttonRow = area.removeFromTop(30).reduced(4);
+    addDeckButton.setBounds(buttonRow.removeFromLeft(80));
+    buttonRow.removeFromLeft(4);
+    removeDeckButton.setBounds(buttonRow.removeFromLeft(80));
+    buttonRow.removeFromLeft(4);
+    statsButton.setBounds(buttonRow.removeFromLeft(60));
+    buttonRow.removeFromLeft(4);
+    exportButton.setBounds(buttonRow.removeFromLeft(70));
+    parallelRenderToggle.setBounds(buttonRow.removeFromRight(170));
+    exportProgressBar.setBounds(parallelRenderToggle.getBounds());
+
+    if (decks.isEmpty())
+        return;
+
+    // one column for up to two decks, then two columns
+    const int columns = decks.size() > 2 ? 2 : 1;
+    const int rows = (decks.size() + columns - 1) / columns;
+    const int deckWidth = area.getWidth() / columns;
+    const int deckHeight = area.getHeight() / rows;
+
+    for (int i = 0; i < decks.size(); ++i)
+        decks[i]->setBounds(area.getX() + (i % columns) * deckWidth, area.getY() + (i / columns) * deckHeight,
+            deckWidth, deckHeight);
 }
 
 
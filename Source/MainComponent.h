@@ -1,28 +1,49 @@
 #pragma once
 
 #include <JuceHeader.h>
-#include "PlayerAudio.h"
 #include "PlayerGUI.h"
+#include "AudioEngine.h"
+#include "MixdownExporter.h"
 
-class MainComponent : public juce::AudioAppComponent
+// The engine's decks with a GUI on each; the engine owns the audio device and the mix
+class MainComponent : public juce::Component,
+    private juce::Timer
 {
 public:
     MainComponent();
     ~MainComponent() override;
 
-    void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
-    void getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill) override;
-    void releaseResources() override;
     void paint(juce::Graphics& g) override;
     void resized() override;
 
 private:
-    std::unique_ptr<PlayerGUI> player1;
-    std::unique_ptr<PlayerGUI> player2;
-    juce::MixerAudioSource mixer;
+    static constexpr int maxVisibleDecks = 8;
+
+    void addDeck();
+    void removeLastDeck();
+    void updateDeckButtons();
+    void showStats();
+    void chooseExportFile();
+    void askExportLength(const juce::File& file);
+    void startExport(const juce::File& file, double lengthSeconds);
+    void exportFinished(bool succeeded, const juce::String& message);
+    void timerCallback() override;
+
+    // declared first, so its decks outlive the GUIs that control them
+    AudioEngine engine;
+    // Player1, Player2, ... so each deck keeps its own session file
+    juce::OwnedArray<PlayerGUI> decks;
+    juce::TextButton addDeckButton{ "+ Deck" }, removeDeckButton{ "- Deck" };
+    juce::ToggleButton parallelRenderToggle{ "Multi-core rendering" };
+    juce::TextButton statsButton{ "Stats" };
+    juce::Component::SafePointer<juce::DialogWindow> statsWindow;
+    juce::TextButton exportButton{ "Export" };
+    MixdownExporter exporter;
+    double exportProgress = 0.0;  // polled by the progress bar
+    juce::ProgressBar exportProgressBar{ exportProgress };
+    std::unique_ptr<juce::AlertWindow> exportLengthPrompt;
     
     std::unique_ptr<juce::FileChooser> fileChooser;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MainComponent)
 };
-
@@ -0,0 +1,71 @@
+/*
+  ==============================================================================
+
+    MappedTrackPrefetcher.cpp
+    Created: 17 Oct 2026 11:40:12am
+
+  ==============================================================================
+*/
+
+#include "MappedTrackPrefetcher.h"
+
+MappedTrackPrefetcher::MappedTrackPrefetcher(juce::MemoryMappedAudioFormatReader& r, juce::TimeSliceThread& thread)
+    : reader(r),
+    backgroundThread(thread),
+    samplesPerPage(juce::jmax(1, 4096 / juce::jmax(1, (int)(r.numChannels * r.bitsPerSample / 8)))),
+    windowSamples((juce::int64)(r.sampleRate * 4.0))
+{
+    backgroundThread.addTimeSliceClient(this);
+}
+
+MappedTrackPrefetcher::~MappedTrackPrefetcher()
+{
+    backgroundThread.removeTimeSliceClient(this);
+}
+
+void MappedTrackPrefetcher::setLoopPoints(juce::int64 sampleA, juce::int64 sampleB)
+{
+    loopA = sampleA;
+    loopB = sampleB;
+    backgroundThread.moveToFrontOfQueue(this);
+}
+
+void MappedTrackPrefetcher::prefetchAround(juce::int64 sample) const
+{
+    touchRange(sample, windowSamples / 8);
+}
+
+void MappedTrackPrefetcher::touchRange(juce::int64 start, juce::int64 numSamples) const
+{
+    const auto end = juce::jmin(start + numSamples, reader.lengthInSamples);
+
+    for (auto s = juce::jmax((juce::int64)0, start); s < end; s += samplesPerPage)
+        reader.touchSample(s);
+}
+
+int MappedTrackPrefetcher::useTimeSlice()
+{
+    const auto pos = playhead.load();
+    const auto a = loopA.load();
+    const auto b = loopB.load();
+
+    if (lastPlayhead < 0 || pos < lastPlayhead || pos - lastPlayhead > windowSamples / 4)
+    {
+        touchRange(pos, windowSamples);
+        lastPlayhead = pos;
+    }
+
+    // the loop wrap jumps back to A, and the run-up to B is played every pass
+    if (a != lastA || b != lastB)
+    {
+        if (a >= 0)
+            touchRange(a, windowSamples / 4);
+        if (b > a)
+            touchRange(b - windowSamples / 4, windowSamples / 4);
+
+        lastA = a;
+        lastB = b;
+    }
+
+    return 50;
+}
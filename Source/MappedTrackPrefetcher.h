@@ -0,0 +1,42 @@
+/*
+  ==============================================================================
+
+    MappedTrackPrefetcher.h
+    Created: 17 Oct 2026 11:40:12am
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// Keeps the pages of a memory-mapped track resident around the playhead and the
+// A/B loop points, so reads from the audio thread never fault to disk.
+class MappedTrackPrefetcher : private juce::TimeSliceClient
+{
+public:
+    MappedTrackPrefetcher(juce::MemoryMappedAudioFormatReader& reader, juce::TimeSliceThread& thread);
+    ~MappedTrackPrefetcher() override;
+
+    // Cheap enough to call from the audio callback; the touching happens on the thread
+    void setPlayhead(juce::int64 sample) { playhead = sample; }
+    void setLoopPoints(juce::int64 sampleA, juce::int64 sampleB);
+
+    // Touches a short window synchronously, used right before a seek
+    void prefetchAround(juce::int64 sample) const;
+
+private:
+    int useTimeSlice() override;
+    void touchRange(juce::int64 start, juce::int64 numSamples) const;
+
+    juce::MemoryMappedAudioFormatReader& reader;
+    juce::TimeSliceThread& backgroundThread;
+    const int samplesPerPage;
+    const juce::int64 windowSamples;
+
+    std::atomic<juce::int64> playhead{ 0 };
+    std::atomic<juce::int64> loopA{ -1 }, loopB{ -1 };
+    juce::int64 lastPlayhead = -1, lastA = -1, lastB = -1;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MappedTrackPrefetcher)
+};
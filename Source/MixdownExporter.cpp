@@ -0,0 +1,200 @@
+/*
+  ==============================================================================
+
+    MixdownExporter.cpp
+    Created: 18 Oct 2026 3:05:12am
+
+  ==============================================================================
+*/
+
+#include "MixdownExporter.h"
+#include "AtomicFile.h"
+
+namespace
+{
+    constexpr int renderBlockSize = 2048;
+    constexpr int numChannels = 2;
+}
+
+MixdownExporter::MixdownExporter()
+    : juce::Thread("Mixdown export")
+{
+    selfReference = this;
+}
+
+MixdownExporter::~MixdownExporter()
+{
+    cancel();
+}
+
+MixdownExporter::Format MixdownExporter::getFormatForFile(const juce::File& file)
+{
+    return file.hasFileExtension("flac") ? Format::flac : Format::wav;
+}
+
+juce::String MixdownExporter::start(const juce::Array<PlayerAudio*>& sourceDecks, const Options& newOptions, Callback onFinished)
+{
+    if (isExporting())
+        return "An export is already running";
+
+    if (newOptions.sampleRate <= 0.0)
+        return "Invalid sample rate";
+
+    cancel();
+    options = newOptions;
+    callback = std::move(onFinished);
+    ++exportGeneration;
+    mixer = std::make_unique<DeckMixer>();
+    mixer->setRenderThreads(options.renderThreads);
+
+    auto fail = [this](const juce::String& error)
+        {
+            mixer.reset();
+            decks.clear();
+            callback = nullptr;
+            return error;
+        };
+
+    double longestSeconds = 0.0;
+    bool anyLooping = false;
+
+    for (auto* source : sourceDecks)
+    {
+        auto file = source->getCurrentFile();
+        if (file == juce::File())
+            continue;
+
+        auto* deck = decks.add(std::make_unique<PlayerAudio>());
+
+        // an offline render outruns any read-ahead thread; read the file directly instead
+        deck->setReadAheadEnabled(false);
+        if (!deck->LoadFile(file))
+            return fail("Could not open " + file.getFileName());
+
+        deck->copySettingsFrom(*source);
+        deck->setPosition(source->getPosition());
+        deck->play();
+        mixer->addDeck(*deck);
+
+        anyLooping = anyLooping || deck->isLooping() || deck->getSegmentLooping();
+        longestSeconds = juce::jmax(longestSeconds,
+            (deck->getLength() - source->getPosition()) / juce::jmax(0.01, (double)deck->getPlaybackRate()));
+    }
+
+    if (decks.isEmpty())
+        return fail("No deck has a track loaded");
+
+    untilStopped = options.lengthSeconds <= 0.0;
+    if (untilStopped && anyLooping)
+        return fail("A looping deck never stops; set an export length");
+
+    expectedSamples = (juce::int64)((untilStopped ? longestSeconds : options.lengthSeconds) * options.sampleRate);
+    progress = 0.0;
+    mixer->prepareToPlay(renderBlockSize, options.sampleRate);
+
+    // below the audio callback's priority, so a live set keeps playing smoothly during an export
+    startThread(juce::Thread::Priority::normal);
+    return {};
+}
+
+void MixdownExporter::cancel()
+{
+    stopThread(10000);
+
+    // the render thread is gone; its completion message still reports the cancellation
+    mixer.reset();
+    decks.clear();
+}
+
+void MixdownExporter::run()
+{
+    auto error = render();
+    auto weakThis = selfReference;
+    auto generation = exportGeneration;
+
+    juce::MessageManager::callAsync([weakThis, error, generation]
+        {
+            // a later export may have started since this one was cancelled
+            if (weakThis != nullptr && weakThis->exportGeneration == generation)
+                weakThis->finish(error);
+        });
+}
+
+juce::String MixdownExporter::render()
+{
+    juce::String error;
+    const bool written = writeFileAtomically(options.file, [this, &error](const juce::File& target)
+        {
+            error = renderTo(target);
+            return error.isEmpty();
+        });
+
+    if (!written)
+        return error.isNotEmpty() ? error : "Could not replace " + options.file.getFullPathName();
+
+    progress = 1.0;
+    return {};
+}
+
+juce::String MixdownExporter::renderTo(const juce::File& target)
+{
+    auto stream = std::make_unique<juce::FileOutputStream>(target);
+    if (stream->failedToOpen())
+        return "Could not write to " + options.file.getParentDirectory().getFullPathName();
+
+    std::unique_ptr<juce::AudioFormat> format;
+    if (options.format == Format::flac)
+        format = std::make_unique<juce::FlacAudioFormat>();
+    else
+        format = std::make_unique<juce::WavAudioFormat>();
+
+    std::unique_ptr<juce::AudioFormatWriter> writer(format->createWriterFor(stream.get(), options.sampleRate,
+        numChannels, options.bitsPerSample, {}, 0));
+    if (writer == nullptr)
+        return format->getFormatName() + " cannot write " + juce::String(options.bitsPerSample) + "-bit audio at "
+            + juce::String(options.sampleRate) + " Hz";
+    stream.release();  // now owned by the writer
+
+    juce::AudioBuffer<float> block(numChannels, renderBlockSize);
+
+    // a tempo change mid-render can stretch the estimate; stop well after it regardless
+    const auto limit = untilStopped ? expectedSamples + expectedSamples / 4 + (juce::int64)(10.0 * options.sampleRate)
+                                    : expectedSamples;
+
+    for (juce::int64 rendered = 0; rendered < limit;)
+    {
+        if (threadShouldExit())
+            return "Export cancelled";
+
+        const int numSamples = (int)juce::jmin((juce::int64)renderBlockSize, limit - rendered);
+        mixer->getNextAudioBlock(juce::AudioSourceChannelInfo(&block, 0, numSamples));
+
+        if (!writer->writeFromAudioSampleBuffer(block, 0, numSamples))
+            return "Writing " + options.file.getFileName() + " failed";
+
+        rendered += numSamples;
+        progress = juce::jlimit(0.0, 1.0, (double)rendered / (double)juce::jmax((juce::int64)1, expectedSamples));
+
+        // this thread plays the part of the audio thread, so it can read the decks' transport state
+        if (untilStopped && std::none_of(decks.begin(), decks.end(), [](PlayerAudio* deck) { return deck->isPlaying(); }))
+            break;
+    }
+
+    // flushes and closes the file before it is moved into place
+    writer.reset();
+    return {};
+}
+
+void MixdownExporter::finish(const juce::String& error)
+{
+    stopThread(1000);
+    mixer.reset();
+    decks.clear();
+
+    if (callback != nullptr)
+    {
+        auto onFinished = std::move(callback);
+        callback = nullptr;
+        onFinished(error.isEmpty(), error);
+    }
+}
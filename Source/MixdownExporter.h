@@ -0,0 +1,69 @@
+/*
+  ==============================================================================
+
+    MixdownExporter.h
+    Created: 18 Oct 2026 3:05:12am
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "PlayerAudio.h"
+#include "DeckMixer.h"
+
+// Renders the decks' mix straight to a WAV or FLAC file, as fast as the CPU
+// allows, on a background thread. Every deck with a track is copied, with its
+// settings, into a private deck and mixer, so the live decks keep playing
+// undisturbed; each copy starts from where its deck is now.
+class MixdownExporter : private juce::Thread
+{
+public:
+    enum class Format { wav, flac };
+
+    struct Options
+    {
+        juce::File file;
+        Format format = Format::wav;
+        double sampleRate = 44100.0;
+        int bitsPerSample = 24;
+        double lengthSeconds = 0.0;  // 0 renders until every deck has stopped; needed if a deck loops
+        int renderThreads = 0;       // as DeckMixer::setRenderThreads
+    };
+
+    // Message thread, once the export has ended; message is empty on success
+    using Callback = std::function<void(bool succeeded, const juce::String& message)>;
+
+    MixdownExporter();
+    // Cancels an export in progress
+    ~MixdownExporter() override;
+
+    // Message thread. Returns an error, or an empty string once the render has started.
+    juce::String start(const juce::Array<PlayerAudio*>& decks, const Options& options, Callback onFinished);
+    void cancel();
+    bool isExporting() const { return isThreadRunning(); }
+
+    // 0 to 1; estimated from the decks' remaining lengths when no length was given
+    double getProgress() const { return progress.load(); }
+
+    static Format getFormatForFile(const juce::File& file);
+
+private:
+    void run() override;
+    juce::String render();
+    juce::String renderTo(const juce::File& target);
+    void finish(const juce::String& error);
+
+    Options options;
+    Callback callback;
+    juce::OwnedArray<PlayerAudio> decks;  // declared before the mixer, so they outlive it
+    std::unique_ptr<DeckMixer> mixer;
+    juce::int64 expectedSamples = 0;
+    bool untilStopped = false;
+    juce::uint32 exportGeneration = 0;  // written before the thread starts, read by it afterwards
+    std::atomic<double> progress{ 0.0 };
+    juce::WeakReference<MixdownExporter> selfReference;
+
+    JUCE_DECLARE_WEAK_REFERENCEABLE(MixdownExporter)
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MixdownExporter)
+};
@@ -0,0 +1,106 @@
+/*
+  ==============================================================================
+
+    PerformanceStats.cpp
+    Created: 18 Oct 2026 1:52:14am
+
+  ==============================================================================
+*/
+
+#include "PerformanceStats.h"
+
+namespace
+{
+    // single writer: plain load and store are enough
+    template <typename Type>
+    void bump(std::atomic<Type>& counter, Type amount = 1)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+
+    double ticksToMicros(juce::int64 ticks)
+    {
+        return juce::Time::highResolutionTicksToSeconds(ticks) * 1.0e6;
+    }
+}
+
+void CallbackStats::prepare(double sampleRate)
+{
+    currentSampleRate = sampleRate > 0.0 ? sampleRate : 44100.0;
+    lastStartTicks = 0;
+}
+
+void CallbackStats::record(juce::int64 startTicks, juce::int64 endTicks, int numSamples)
+{
+    if (resetRequested.exchange(false))
+    {
+        for (auto& bin : histogram)
+            bin.store(0, std::memory_order_relaxed);
+        callbacks.store(0, std::memory_order_relaxed);
+        deadlineMisses.store(0, std::memory_order_relaxed);
+        callbackGaps.store(0, std::memory_order_relaxed);
+        totalTicks.store(0, std::memory_order_relaxed);
+        maxTicks.store(0, std::memory_order_relaxed);
+    }
+
+    const double deadlineSeconds = numSamples / currentSampleRate.load(std::memory_order_relaxed);
+    const auto elapsed = endTicks - startTicks;
+    const double fraction = juce::Time::highResolutionTicksToSeconds(elapsed) / deadlineSeconds;
+
+    bump(histogram[(size_t)juce::jmin(numBins - 1, (int)(fraction * 100.0 / binPercent))]);
+    bump(callbacks, 1u);
+    bump(totalTicks, elapsed);
+
+    if (elapsed > maxTicks.load(std::memory_order_relaxed))
+        maxTicks.store(elapsed, std::memory_order_relaxed);
+    if (fraction > 1.0)
+        bump(deadlineMisses, 1u);
+
+    // a callback arriving well after the previous block ran out means the device had nothing to play
+    if (lastStartTicks != 0
+        && juce::Time::highResolutionTicksToSeconds(startTicks - lastStartTicks) > 1.5 * deadlineSeconds)
+        bump(callbackGaps, 1u);
+
+    lastStartTicks = startTicks;
+    lastDeadlineMicros.store(deadlineSeconds * 1.0e6, std::memory_order_relaxed);
+}
+
+CallbackStats::Snapshot CallbackStats::getSnapshot() const
+{
+    Snapshot snapshot;
+
+    for (size_t i = 0; i < histogram.size(); ++i)
+        snapshot.histogram[i] = histogram[i].load(std::memory_order_relaxed);
+
+    snapshot.callbacks = callbacks.load(std::memory_order_relaxed);
+    snapshot.deadlineMisses = deadlineMisses.load(std::memory_order_relaxed);
+    snapshot.callbackGaps = callbackGaps.load(std::memory_order_relaxed);
+    snapshot.meanMicros = snapshot.callbacks > 0 ? ticksToMicros(totalTicks.load(std::memory_order_relaxed)) / snapshot.callbacks : 0.0;
+    snapshot.maxMicros = ticksToMicros(maxTicks.load(std::memory_order_relaxed));
+    snapshot.deadlineMicros = lastDeadlineMicros.load(std::memory_order_relaxed);
+    return snapshot;
+}
+
+juce::String CallbackStats::createReport(const Snapshot& snapshot)
+{
+    juce::String report;
+    report << "callbacks: " << (int)snapshot.callbacks
+        << ", deadline " << juce::String(snapshot.deadlineMicros, 1) << " us"
+        << ", mean " << juce::String(snapshot.meanMicros, 1) << " us"
+        << ", max " << juce::String(snapshot.maxMicros, 1) << " us\n"
+        << "deadline misses: " << (int)snapshot.deadlineMisses
+        << ", callback gaps: " << (int)snapshot.callbackGaps << "\n"
+        << "duration histogram (% of deadline: callbacks):\n";
+
+    for (int i = 0; i < numBins; ++i)
+    {
+        if (snapshot.histogram[(size_t)i] == 0)
+            continue;
+
+        report << "  " << (i == numBins - 1 ? juce::String(">=") + juce::String(i * binPercent)
+                                            : juce::String(i * binPercent) + "-" + juce::String((i + 1) * binPercent))
+            << "%: " << (int)snapshot.histogram[(size_t)i] << "\n";
+    }
+
+    return report;
+}
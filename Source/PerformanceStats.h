@@ -0,0 +1,105 @@
+/*
+  ==============================================================================
+
+    PerformanceStats.h
+    Created: 18 Oct 2026 1:52:14am
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// Always-on timing of the audio callback: a histogram of callback durations as a
+// share of the block's deadline, deadline misses, and gaps between callbacks long
+// enough to mean the device dropped a buffer. The audio thread only bumps relaxed
+// counters; any thread can take a snapshot.
+class CallbackStats
+{
+public:
+    static constexpr int binPercent = 5;     // each bin covers 5% of the deadline
+    static constexpr int numBins = 41;       // the last one collects everything from 200% up
+
+    struct Snapshot
+    {
+        std::array<juce::uint32, numBins> histogram{};
+        juce::uint32 callbacks = 0;
+        juce::uint32 deadlineMisses = 0;
+        juce::uint32 callbackGaps = 0;
+        double meanMicros = 0.0;
+        double maxMicros = 0.0;
+        double deadlineMicros = 0.0;          // of the most recent callback
+    };
+
+    // Before the first callback; also starts a fresh gap measurement
+    void prepare(double sampleRate);
+    // Audio thread, once per callback
+    void record(juce::int64 startTicks, juce::int64 endTicks, int numSamples);
+    // Any thread; the counters restart on the next callback
+    void reset() { resetRequested = true; }
+
+    Snapshot getSnapshot() const;
+    static juce::String createReport(const Snapshot& snapshot);
+
+private:
+    std::atomic<double> currentSampleRate{ 44100.0 };
+    std::atomic<bool> resetRequested{ false };
+    juce::int64 lastStartTicks = 0;
+
+    std::array<std::atomic<juce::uint32>, numBins> histogram{};
+    std::atomic<juce::uint32> callbacks{ 0 }, deadlineMisses{ 0 }, callbackGaps{ 0 };
+    std::atomic<juce::int64> totalTicks{ 0 }, maxTicks{ 0 };
+    std::atomic<double> lastDeadlineMicros{ 0.0 };
+};
+
+// Where one deck's share of the callback goes: reading and decoding its tracks,
+// its own DSP (speed, stretch, loop, gain/pan) and being summed into the mix.
+// Totals in high-resolution ticks, only ever added to by the audio thread.
+struct DeckLoadStats
+{
+    std::atomic<juce::int64> decodeTicks{ 0 };
+    std::atomic<juce::int64> dspTicks{ 0 };
+    std::atomic<juce::int64> mixTicks{ 0 };
+
+    // audio thread only: a single writer, so no read-modify-write is needed
+    static void add(std::atomic<juce::int64>& total, juce::int64 ticks)
+    {
+        total.store(total.load(std::memory_order_relaxed) + ticks, std::memory_order_relaxed);
+    }
+};
+
+// Forwards to another positionable source, adding up the time spent inside its
+// getNextAudioBlock. Wrapped around a deck's track chain it measures decoding.
+class TimedSource : public juce::PositionableAudioSource
+{
+public:
+    explicit TimedSource(juce::PositionableAudioSource& s) : source(s) {}
+
+    // ticks spent in the source since the last call; audio thread
+    juce::int64 takeElapsedTicks()
+    {
+        auto ticks = elapsedTicks;
+        elapsedTicks = 0;
+        return ticks;
+    }
+
+    void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override { source.prepareToPlay(samplesPerBlockExpected, sampleRate); }
+    void releaseResources() override { source.releaseResources(); }
+
+    void getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill) override
+    {
+        auto start = juce::Time::getHighResolutionTicks();
+        source.getNextAudioBlock(bufferToFill);
+        elapsedTicks += juce::Time::getHighResolutionTicks() - start;
+    }
+
+    void setNextReadPosition(juce::int64 newPosition) override { source.setNextReadPosition(newPosition); }
+    juce::int64 getNextReadPosition() const override { return source.getNextReadPosition(); }
+    juce::int64 getTotalLength() const override { return source.getTotalLength(); }
+    bool isLooping() const override { return source.isLooping(); }
+    void setLooping(bool shouldLoop) override { source.setLooping(shouldLoop); }
+
+private:
+    juce::PositionableAudioSource& source;
+    juce::int64 elapsedTicks = 0;
+};
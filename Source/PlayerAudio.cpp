@@ -3,32 +3,100 @@
 PlayerAudio::PlayerAudio()
 {
     formatManager.registerBasicFormats();
+    transportSource.addChangeListener(this);
 }
 
 PlayerAudio::~PlayerAudio()
 {
+    cancelPendingUpdate();
+    transportSource.removeChangeListener(this);
+    transportSource.setSource(nullptr);
     releaseResources();
 }
 
 void PlayerAudio::prepareToPlay(int samplesPerBlockExpected, double sampleRate)
 {
+    // the callback is not rendering this deck yet, so start at the published settings instead of gliding to them
+    {
+        const juce::ScopedLock sl(detachedLock);
+        if (parameterSnapshot.fetch(audioParameters))
+            applyAudioParameters();
+    }
+
+    deviceSampleRate = sampleRate;
+    playheadSpeed = 0.0;
+    transportFade.prepare(sampleRate);
+    gainPan.prepare(sampleRate);
     transportSource.prepareToPlay(samplesPerBlockExpected, sampleRate);
 }
 
 void PlayerAudio::getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill)
 {
-    transportSource.getNextAudioBlock(bufferToFill);
-    checkSegmentLoop();
-    // Apply panning (left/right balance)
-    if (bufferToFill.buffer->getNumChannels() > 1)
-    {
-        float leftGain = 1.0f - static_cast<float>(pan);
-        float rightGain = static_cast<float>(pan);
+    if (!renderNextBlock(bufferToFill))
+        bufferToFill.clearActiveBufferRegion();
+}
 
-        bufferToFill.buffer->applyGain(0, bufferToFill.startSample, bufferToFill.numSamples, leftGain);
-        bufferToFill.buffer->applyGain(1, bufferToFill.startSample, bufferToFill.numSamples, rightGain);
+bool PlayerAudio::renderNextBlock(const juce::AudioSourceChannelInfo& bufferToFill)
+{
+    applyPendingChanges();
+
+    // taken first: a track installed from here on makes this block's playhead stale, not wrong
+    const auto generation = trackGeneration.load();
+    auto startTicks = juce::Time::getHighResolutionTicks();
+    const auto startSample = varispeed.getNextReadPosition();
+
+    if (!running.load())
+    {
+        // still published while stopped, so a seek shows up at once
+        publishPlayhead(generation, startTicks, startSample, startSample, bufferToFill.numSamples);
+        return false;
     }
 
+    transportSource.getNextAudioBlock(bufferToFill);
+    publishPlayhead(generation, startTicks, startSample, varispeed.getNextReadPosition(), bufferToFill.numSamples);
+    transportFade.process(*bufferToFill.buffer, bufferToFill.startSample, bufferToFill.numSamples);
+
+    // a stop halts the transport only once its fade-out has reached silence
+    if (transportFade.isSilent())
+        running = false;
+
+    // a muted deck keeps playing, it just has nothing to add
+    bool audible = !gainPan.isSilent();
+    if (audible)
+        gainPan.process(*bufferToFill.buffer, bufferToFill.startSample, bufferToFill.numSamples);
+
+    // whatever the track chain itself did not take was this deck's own processing
+    auto decodeTicks = decodeTimer.takeElapsedTicks();
+    DeckLoadStats::add(loadStats.decodeTicks, decodeTicks);
+    DeckLoadStats::add(loadStats.dspTicks, juce::Time::getHighResolutionTicks() - startTicks - decodeTicks);
+    return audible;
+}
+
+void PlayerAudio::publishPlayhead(juce::uint32 generation, juce::int64 startTicks, juce::int64 startSample, juce::int64 endSample, int numSamples)
+{
+    if (deviceSampleRate <= 0.0 || numSamples <= 0)
+        return;
+
+    const double sourceRate = varispeed.getSourceSampleRate() > 0.0 ? varispeed.getSourceSampleRate() : deviceSampleRate;
+    const double blockSeconds = numSamples / deviceSampleRate;
+    const double advanced = (double)(endSample - startSample) / sourceRate;
+
+    // the time-stretcher moves through its input a frame at a time, so the speed is averaged
+    // over about a tenth of a second. A seek, loop or track change inside the block says
+    // nothing about it, and a block starting from standstill takes its speed at once.
+    if (endSample == startSample)
+        playheadSpeed = 0.0;
+    else if (advanced > 0.0 && advanced < 16.0 * blockSeconds)
+        playheadSpeed = playheadSpeed == 0.0 ? advanced / blockSeconds
+                                             : playheadSpeed + (advanced / blockSeconds - playheadSpeed) * juce::jmin(1.0, blockSeconds / 0.1);
+
+    PlayheadState state;
+    state.position = (double)startSample / sourceRate;
+    state.speed = playheadSpeed;
+    state.hostTicks = startTicks;
+    state.blockSeconds = blockSeconds;
+    state.generation = generation;
+    playheadClock.publish(state);
 }
 
 void PlayerAudio::releaseResources()
@@ -36,146 +104,583 @@ void PlayerAudio::releaseResources()
     transportSource.releaseResources();
 }
 
+void PlayerAudio::pushCommand(DeckCommand::Type type, juce::int64 position)
+{
+    commands.push({ type, position, trackGeneration.load() });
+
+    // No callback would pick it up. The lock keeps this from racing the thread that detaches
+    // the deck, which applies whatever is left as it does so.
+    const juce::ScopedLock sl(detachedLock);
+    if (!attached.load())
+        applyPendingChanges();
+}
+
+void PlayerAudio::setAttached(bool isAttached)
+{
+    const juce::ScopedLock sl(detachedLock);
+    const bool wasAttached = attached.exchange(isAttached);
+
+    // whatever was pushed for a callback that never came is applied now
+    if (wasAttached && !isAttached)
+        applyPendingChanges();
+}
+
+void PlayerAudio::publishParameters()
+{
+    if (currentTrack != nullptr)
+        parameters.seamCrossfadeSamples = juce::roundToInt(seamCrossfadeSeconds * currentTrack->getSampleRate());
+
+    parameterSnapshot.publish(parameters);
+}
+
+void PlayerAudio::applyPendingChanges()
+{
+    auto generation = trackGeneration.load();
+
+    commands.drain([this, generation](const DeckCommand& command)
+        {
+            switch (command.type)
+            {
+            case DeckCommand::Type::play:
+                // also needed while running: attaching a new track leaves the transport stopped
+                transportSource.start();
+                running = true;
+                transportFade.fadeIn();
+                break;
+
+            case DeckCommand::Type::stop:
+                transportFade.fadeOut();
+                // with no callback to render the fade, halt at once
+                if (!attached.load())
+                    running = false;
+                break;
+
+            case DeckCommand::Type::seek:
+                // a seek issued against a track that has since been replaced is dropped
+                if (command.generation == generation)
+                    transportSource.setNextReadPosition(command.position);
+                break;
+
+            case DeckCommand::Type::restart:
+                // the rewind arrives as a seek, just before this
+                transportSource.start();
+                running = true;
+                transportFade.fadeInFromSilence();
+                break;
+            }
+        });
+
+    if (parameterSnapshot.fetch(audioParameters))
+        applyAudioParameters();
+}
+
+void PlayerAudio::applyAudioParameters()
+{
+    // the transport's own gain stays at 1, so it skips its pass
+    gainPan.setTargets(audioParameters.muted ? 0.0f : audioParameters.gain, audioParameters.pan);
+    segmentLoop.setLoopRange(audioParameters.loopStartSample, audioParameters.loopEndSample,
+        audioParameters.segmentLooping);
+    segmentLoop.setSeamCrossfadeLength(audioParameters.seamCrossfadeSamples);
+    varispeed.setSpeed(audioParameters.varispeed);
+    varispeed.setNudge(audioParameters.nudge);
+    timeStretch.setStretchRatio(audioParameters.stretchRatio);
+    timeStretch.setQuality(audioParameters.stretchQuality);
+    varispeed.setQuality(audioParameters.resamplerQuality);
+    transportFade.setShape(audioParameters.transportFadeSeconds, audioParameters.transportFadeCurve);
+}
+
 bool PlayerAudio::LoadFile(const juce::File& file)
 {
-    if (file.existsAsFile())
+    return installTrack(prepareTrack(file));
+}
+
+std::unique_ptr<PreparedTrack> PlayerAudio::prepareTrack(const juce::File& file) const
+{
+    if (!file.existsAsFile())
+        return nullptr;
+
+    auto startTime = juce::Time::getMillisecondCounterHiRes();
+    auto track = std::make_unique<PreparedTrack>();
+    track->file = file;
+
+    if (auto cached = decodedCacheEnabled ? trackCache->find(file) : nullptr)
+    {
+        track->reader = std::make_unique<DecodedTrackReader>(std::move(cached));
+        track->fromCache = true;
+    }
+    else
     {
-        if (auto* reader = formatManager.createReaderFor(file))
+        track->mappedReader = memoryMappingEnabled ? createMappedReader(file) : nullptr;
+        track->reader.reset(track->mappedReader);
+
+        if (track->reader == nullptr)
         {
-            transportSource.stop();
-            transportSource.setSource(nullptr);
-            readerSource.reset();
+            track->reader.reset(formatManager.createReaderFor(file));
+
+            // decode once in the background so the next load of this file is served from RAM
+            if (track->reader != nullptr && decodedCacheEnabled)
+                trackCache->decodeInBackground(file);
+        }
+    }
+
+    if (track->reader == nullptr)
+        return nullptr;
 
-            readerSource = std::make_unique<juce::AudioFormatReaderSource>(reader, true);
+    track->openMilliseconds = juce::Time::getMillisecondCounterHiRes() - startTime;
+    return track;
+}
+
+bool PlayerAudio::installTrack(std::unique_ptr<PreparedTrack> track)
+{
+    auto loaded = createLoadedTrack(std::move(track));
+    if (loaded == nullptr)
+        return false;
 
-            transportSource.setSource(readerSource.get(), 0, nullptr, reader->sampleRate);
-            return true;
+    // once detached the audio thread cannot switch tracks, so both old tracks can simply go
+    transportSource.setSource(nullptr);
+    ++trackGeneration;
+    cancelPendingUpdate();
+    sourceChain.setCurrentTrack(nullptr);
+    sourceChain.queueNextTrack(nullptr);
+    queuedInChain = false;
+    queuedTrack.reset();
+    fadingOutTrack.reset();
+    currentTrack = std::move(loaded);
+
+    updatePrefetchLoopPoints();
+    publishParameters();
+    attachSource();
+    return true;
+}
+
+std::unique_ptr<LoadedTrack> PlayerAudio::createLoadedTrack(std::unique_ptr<PreparedTrack> prepared)
+{
+    if (prepared == nullptr || prepared->reader == nullptr)
+        return nullptr;
+
+    auto track = std::make_unique<LoadedTrack>();
+    track->file = prepared->file;
+    track->fromCache = prepared->fromCache;
+    track->readerSource = std::make_unique<juce::AudioFormatReaderSource>(prepared->reader.release(), true);
+    track->readerSource->setLooping(islooping);
+
+    if (prepared->mappedReader != nullptr)
+        track->prefetcher = std::make_unique<MappedTrackPrefetcher>(*prepared->mappedReader, *readAheadThread);
+
+    buildReadAhead(*track);
+    return track;
+}
+
+void PlayerAudio::buildReadAhead(LoadedTrack& track)
+{
+    track.readAheadSource.reset();
+
+    // mapped and cached readers never touch the disk on read, so they need no read-ahead
+    if (readAheadEnabled && track.prefetcher == nullptr && !track.fromCache)
+    {
+        // at least two channels so mono files still fill both outputs, as the reader source does
+        int numChannels = juce::jmax(2, (int)track.getReader().numChannels);
+        track.readAheadSource = std::make_unique<ReadAheadAudioSource>(track.readerSource.get(), *readAheadThread,
+            false, readAheadBufferSize, numChannels);
+    }
+}
+
+juce::MemoryMappedAudioFormatReader* PlayerAudio::createMappedReader(const juce::File& file) const
+{
+    // only uncompressed formats (WAV/AIFF) implement memory-mapped readers
+    auto* format = formatManager.findFormatForFileExtension(file.getFileExtension());
+    if (format == nullptr)
+        return nullptr;
+
+    std::unique_ptr<juce::MemoryMappedAudioFormatReader> reader(format->createMemoryMappedReader(file));
+    if (reader == nullptr || reader->lengthInSamples <= 0 || !reader->mapEntireFile())
+        return nullptr;
+
+    return reader.release();
+}
+
+void PlayerAudio::setMemoryMappingEnabled(bool shouldMap)
+{
+    if (memoryMappingEnabled == shouldMap)
+        return;
+
+    memoryMappingEnabled = shouldMap;
+
+    if (currentTrack != nullptr && currentTrack->file.existsAsFile())
+    {
+        bool wasPlaying = isPlaying();
+        double currentPos = getPosition();
+
+        if (LoadFile(currentTrack->file))
+        {
+            setPosition(currentPos);
+            if (wasPlaying)
+                play();
         }
     }
-    return false;
 }
 
-void PlayerAudio::play() { transportSource.start(); }
+void PlayerAudio::updatePrefetchLoopPoints()
+{
+    if (currentTrack == nullptr)
+        return;
+
+    // keep the audio just after A resident, so the wrap at B never waits for the disk
+    if (currentTrack->prefetcher != nullptr)
+        currentTrack->prefetcher->setLoopPoints(parameters.loopStartSample, parameters.loopEndSample);
+    if (currentTrack->readAheadSource != nullptr)
+        currentTrack->readAheadSource->setPinnedRegion(parameters.loopStartSample);
+}
+
+juce::int64 PlayerAudio::secondsToSourceSamples(double seconds) const
+{
+    // positions stay in the file's own samples; rate conversion happens later, in the varispeed stage
+    if (currentTrack == nullptr || seconds < 0)
+        return -1;
+    return (juce::int64)(seconds * currentTrack->getSampleRate());
+}
+
+void PlayerAudio::attachSource()
+{
+    transportSource.setSource(nullptr);
+
+    if (currentTrack == nullptr)
+        return;
+
+    // this also drops any voice that was still fading out
+    sourceChain.setCurrentTrack(currentTrack.get());
+    fadingOutTrack.reset();
+
+    // the varispeed stage converts from the file's rate, so the transport gets no resampler of its own
+    varispeed.setSourceSampleRate(currentTrack->getSampleRate());
+    transportSource.setSource(&varispeed);
+}
+
+void PlayerAudio::reattachSource()
+{
+    if (currentTrack == nullptr)
+        return;
+
+    bool wasPlaying = isPlaying();
+    double currentPos = getPosition();
+
+    transportSource.setSource(nullptr);
+
+    // a switch the audio thread made before detaching is adopted first
+    handleUpdateNowIfNeeded();
+
+    // the settings changed under the tracks, so rebuild their read-ahead wrappers too
+    sourceChain.queueNextTrack(nullptr);
+    buildReadAhead(*currentTrack);
+    attachSource();
+
+    if (queuedTrack != nullptr)
+    {
+        buildReadAhead(*queuedTrack);
+        if (queuedInChain)
+            sourceChain.queueNextTrack(queuedTrack.get());
+    }
+
+    updatePrefetchLoopPoints();
+
+    setPosition(currentPos);
+
+    if (wasPlaying)
+        play();
+}
+
+void PlayerAudio::setReadAheadEnabled(bool shouldReadAhead)
+{
+    if (readAheadEnabled == shouldReadAhead)
+        return;
+
+    readAheadEnabled = shouldReadAhead;
+    reattachSource();
+}
+
+void PlayerAudio::setReadAheadBufferSize(int numSamples)
+{
+    if (numSamples <= 0 || numSamples == readAheadBufferSize)
+        return;
+
+    readAheadBufferSize = numSamples;
+    if (readAheadEnabled)
+        reattachSource();
+}
+
+float PlayerAudio::getReadAheadFillLevel() const
+{
+    if (currentTrack == nullptr || currentTrack->readAheadSource == nullptr)
+        return 0.0f;
+    return currentTrack->readAheadSource->getFillLevel();
+}
+
+int PlayerAudio::getReadAheadUnderruns() const
+{
+    if (currentTrack == nullptr || currentTrack->readAheadSource == nullptr)
+        return 0;
+    return currentTrack->readAheadSource->getUnderrunCount();
+}
+
+const juce::AudioFormatReader* PlayerAudio::getCurrentReader() const
+{
+    return currentTrack != nullptr ? &currentTrack->getReader() : nullptr;
+}
+
+void PlayerAudio::setGaplessEnabled(bool shouldBeGapless)
+{
+    gaplessEnabled = shouldBeGapless;
+    if (!gaplessEnabled)
+        clearQueuedTrack();
+}
+
+void PlayerAudio::queueNextTrack(std::unique_ptr<PreparedTrack> track)
+{
+    clearQueuedTrack();
+
+    if (!gaplessEnabled || currentTrack == nullptr)
+        return;
+
+    queuedTrack = createLoadedTrack(std::move(track));
+    if (queuedTrack == nullptr)
+        return;
+
+    // the varispeed stage converts from a fixed source rate, so only a matching track can follow seamlessly;
+    // anything else waits in queuedTrack for the end-of-stream fallback
+    if (queuedTrack->getSampleRate() == currentTrack->getSampleRate())
+    {
+        sourceChain.queueNextTrack(queuedTrack.get());
+        queuedInChain = true;
+    }
+}
 
-void PlayerAudio::stop()
+void PlayerAudio::clearQueuedTrack()
 {
-    float currentGain = transportSource.getGain();
-    const int fadeSteps = 20;
-    const float decrement = currentGain / fadeSteps;
+    if (queuedTrack == nullptr)
+        return;
 
-    for (int i = 0; i < fadeSteps; ++i)
+    bool takenByAudioThread = queuedInChain && sourceChain.queueNextTrack(nullptr) == nullptr;
+    if (!takenByAudioThread)
     {
-        transportSource.setGain(currentGain - decrement * i);
-        juce::Thread::sleep(150);
+        queuedInChain = false;
+        queuedTrack.reset();
+        return;
     }
 
-    transportSource.stop();
-    transportSource.setGain(currentGain);
+    // the switch already happened; adopt it now rather than wait for the notification
+    cancelPendingUpdate();
+    handleAsyncUpdate();
+}
+
+bool PlayerAudio::crossfadeToQueuedTrack()
+{
+    if (!queuedInChain || sourceChain.getCrossfadeSeconds() <= 0.0 || !transportSource.isPlaying())
+        return false;
 
+    sourceChain.startCrossfadeNow();
+    return true;
 }
 
-void PlayerAudio::Restart() {
-    transportSource.setPosition(0.0);
-    transportSource.start();
+void PlayerAudio::handleAsyncUpdate()
+{
+    // a finished fade: the audio thread no longer reads the outgoing track
+    if (fadingOutTrack != nullptr && sourceChain.getOutgoingTrack() != fadingOutTrack.get())
+        fadingOutTrack.reset();
+
+    // the chain switched to the queued track on the audio thread; take ownership to match
+    if (!queuedInChain || queuedTrack == nullptr || sourceChain.hasQueuedTrack())
+        return;
+
+    queuedInChain = false;
+    auto finished = std::move(currentTrack);
+    currentTrack = std::move(queuedTrack);
+
+    // keep the old track alive until its fade-out has been rendered
+    if (sourceChain.getOutgoingTrack() == finished.get())
+        fadingOutTrack = std::move(finished);
+    finished.reset();
+
+    updatePrefetchLoopPoints();
+
+    if (onTrackAdvanced != nullptr)
+        onTrackAdvanced();
+}
+
+void PlayerAudio::changeListenerCallback(juce::ChangeBroadcaster*)
+{
+    // end-of-stream fallback for a queued track that could not be chained seamlessly
+    if (!gaplessEnabled || queuedTrack == nullptr || queuedInChain
+        || transportSource.isPlaying() || !transportSource.hasStreamFinished())
+        return;
+
+    transportSource.setSource(nullptr);
+    ++trackGeneration;
+    sourceChain.setCurrentTrack(nullptr);
+    fadingOutTrack.reset();
+    currentTrack = std::move(queuedTrack);
+
+    updatePrefetchLoopPoints();
+    attachSource();
+    play();
+
+    if (onTrackAdvanced != nullptr)
+        onTrackAdvanced();
+}
+
+void PlayerAudio::play() { pushCommand(DeckCommand::Type::play); }
+
+void PlayerAudio::stop() { pushCommand(DeckCommand::Type::stop); }
+
+void PlayerAudio::Restart() { pushCommand(DeckCommand::Type::restart); }
+
+void PlayerAudio::copySettingsFrom(const PlayerAudio& other)
+{
+    // loop points are in the track's own samples, so they carry over when both decks hold the same file
+    parameters = other.parameters;
+    seamCrossfadeSeconds = other.seamCrossfadeSeconds;
+    playbackRate = other.playbackRate;
+    keyLockEnabled = other.keyLockEnabled;
+    setLooping(other.islooping);
+    publishParameters();
+    updatePrefetchLoopPoints();
+}
+
+void PlayerAudio::setTransportFade(double seconds, CrossfadeCurve curve)
+{
+    parameters.transportFadeSeconds = juce::jlimit(0.0, 10.0, seconds);
+    parameters.transportFadeCurve = curve;
+    publishParameters();
 }
 
 void PlayerAudio::skipForward(double seconds)
 {
-    auto newPos = transportSource.getCurrentPosition() + seconds;
-    transportSource.setPosition(std::min(newPos, transportSource.getLengthInSeconds()));
+    auto newPos = getPosition() + seconds;
+    setPosition(std::min(newPos, getLength()));
 }
 
 void PlayerAudio::skipBackward(double seconds)
 {
-    auto newPos = transportSource.getCurrentPosition() - seconds;
-    transportSource.setPosition(std::max(0.0, newPos));
+    auto newPos = getPosition() - seconds;
+    setPosition(std::max(0.0, newPos));
 }
 void PlayerAudio::setGain(float gain)
 {
-    transportSource.setGain(gain);
+    parameters.gain = gain;
+    publishParameters();
+}
+
+void PlayerAudio::setPan(double newPan)
+{
+    parameters.pan = newPan;
+    publishParameters();
 }
 
 void PlayerAudio::setPosition(double pos)
 {
-    transportSource.setPosition(pos);
+    auto target = juce::jmax((juce::int64)0, secondsToSourceSamples(pos));
+
+    // fault the target pages in here rather than on the audio thread
+    if (currentTrack != nullptr && currentTrack->prefetcher != nullptr)
+        currentTrack->prefetcher->prefetchAround(target);
+
+    pushCommand(DeckCommand::Type::seek, target);
 }
 
 double PlayerAudio::getPosition() const
 {
-    return transportSource.getCurrentPosition();
+    if (currentTrack == nullptr)
+        return 0.0;
+    return (double)varispeed.getNextReadPosition() / currentTrack->getSampleRate();
+}
+
+double PlayerAudio::getHeardPosition()
+{
+    if (currentTrack == nullptr)
+        return 0.0;
+
+    auto heard = playheadClock.getHeardPosition(trackGeneration.load());
+    return heard >= 0.0 ? heard : getPosition();
 }
 
 double PlayerAudio::getLength() const
 {
-    return transportSource.getLengthInSeconds();
+    if (currentTrack == nullptr)
+        return 0.0;
+    return (double)varispeed.getTotalLength() / currentTrack->getSampleRate();
 }
 void PlayerAudio::mute()
 {
-    if (!isMuted)
-    {
-        previousGain = transportSource.getGain();
-        transportSource.setGain(0.0f);
-        isMuted = true;
-    }
-
-
+    parameters.muted = true;
+    publishParameters();
 }
 void PlayerAudio::goToEnd()
 {
-    transportSource.setPosition(transportSource.getLengthInSeconds());
+    setPosition(getLength());
 }
 void PlayerAudio::unmute()
 {
-    if (isMuted)
-    {
-        transportSource.setGain(previousGain);
-        isMuted = false;
-    }
+    parameters.muted = false;
+    publishParameters();
 }
 
 void PlayerAudio::setPlaybackRate(float rate)
 {
     if (rate <= 0.0f || rate > 3.0f) return;
 
-    if (!readerSource) return;
-
-    auto* reader = readerSource->getAudioFormatReader();
-    if (!reader) return;
-
-
-    bool wasPlaying = transportSource.isPlaying();
-    double currentPos = transportSource.getCurrentPosition();
+    playbackRate = rate;
+    updateSpeedParameters();
+}
 
+void PlayerAudio::updateSpeedParameters()
+{
+    // both glide inside the render chain; the transport and the reader are never touched
+    parameters.varispeed = keyLockEnabled ? 1.0 : (double)playbackRate;
+    parameters.stretchRatio = keyLockEnabled ? (double)playbackRate : 0.0;
+    publishParameters();
+}
 
-    transportSource.stop();
-    transportSource.setSource(nullptr);
+void PlayerAudio::setNudge(double amount)
+{
+    parameters.nudge = juce::jlimit(-0.5, 0.5, amount);
+    publishParameters();
+}
 
-    double newSampleRate = reader->sampleRate * rate;
-    transportSource.setSource(readerSource.get(), 0, nullptr, newSampleRate);
+float PlayerAudio::getPlaybackRate() const
+{
+    return playbackRate;
+}
 
+void PlayerAudio::setKeyLockEnabled(bool shouldLockKey)
+{
+    if (keyLockEnabled == shouldLockKey)
+        return;
 
-    if (wasPlaying)
-    {
-        transportSource.setPosition(currentPos);
-        transportSource.start();
-    }
+    keyLockEnabled = shouldLockKey;
+    updateSpeedParameters();
+}
 
-    playbackRate = rate;
+void PlayerAudio::setTimeStretchQuality(TimeStretchQuality quality)
+{
+    parameters.stretchQuality = quality;
+    publishParameters();
 }
 
-float PlayerAudio::getPlaybackRate() const
+void PlayerAudio::setResamplerQuality(ResamplerQuality quality)
 {
-    return playbackRate;
+    parameters.resamplerQuality = quality;
+    publishParameters();
 }
 
 
 void PlayerAudio::setLooping(bool shouldLoop)
 {
     islooping = shouldLoop;
-    if (readerSource != nullptr)
+    if (currentTrack != nullptr)
     {
-        readerSource->setLooping(shouldLoop);
+        currentTrack->readerSource->setLooping(shouldLoop);
     }
+    if (queuedTrack != nullptr)
+        queuedTrack->readerSource->setLooping(shouldLoop);
 }
 
 bool PlayerAudio::isLooping() const
@@ -185,34 +690,33 @@ bool PlayerAudio::isLooping() const
 
 void PlayerAudio::setLoopPointA(double position)
 {
-    pointA = position;
+    parameters.loopStartSample = secondsToSourceSamples(position);
+    publishParameters();
+    updatePrefetchLoopPoints();
 }
 
 void PlayerAudio::setLoopPointB(double position)
 {
-    pointB = position;
+    parameters.loopEndSample = secondsToSourceSamples(position);
+    publishParameters();
+    updatePrefetchLoopPoints();
 }
 
 void PlayerAudio::enableSegmentLoop(bool shouldLoop)
 {
-    isSegmentLooping = shouldLoop;
+    parameters.segmentLooping = shouldLoop;
+    publishParameters();
 }
 
-void PlayerAudio::checkSegmentLoop()
+void PlayerAudio::setSeamCrossfade(double seconds)
 {
-    if (isSegmentLooping && pointA >= 0 && pointB > pointA)
-    {
-        double pos = transportSource.getCurrentPosition();
-        if (pos >= pointB)
-        {
-            transportSource.setPosition(pointA);
-        }
-    }
+    seamCrossfadeSeconds = juce::jlimit(0.0, 0.05, seconds);
+    publishParameters();
 }
 
 bool PlayerAudio::isPlaying() const
 {
-    return transportSource.isPlaying();
+    return running.load() && transportSource.isPlaying();
 }
 
 
@@ -1,7 +1,31 @@
 #pragma once
 #include <JuceHeader.h>
+#include "ReadAheadAudioSource.h"
+#include "MappedTrackPrefetcher.h"
+#include "DecodedTrackCache.h"
+#include "LoadedTrack.h"
+#include "GaplessSourceChain.h"
+#include "DeckControl.h"
+#include "SegmentLoopSource.h"
+#include "VarispeedSource.h"
+#include "GainPanStage.h"
+#include "PerformanceStats.h"
+#include "PlayheadClock.h"
 
-class PlayerAudio : public juce::AudioSource
+// A track whose reader has been opened (possibly on a worker thread) but not yet
+// swapped into a deck's transport
+struct PreparedTrack
+{
+    juce::File file;
+    std::unique_ptr<juce::AudioFormatReader> reader;
+    juce::MemoryMappedAudioFormatReader* mappedReader = nullptr;  // aliases reader when mapped
+    bool fromCache = false;
+    double openMilliseconds = 0.0;
+};
+
+class PlayerAudio : public juce::AudioSource,
+    private juce::AsyncUpdater,
+    private juce::ChangeListener
 {
 public:
     PlayerAudio();
@@ -10,12 +34,31 @@ public:
     void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
     void getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill) override;
     void releaseResources() override;
+    // getNextAudioBlock for a mixer: false if the deck is stopped or muted, in which
+    // case the buffer's contents are undefined and should be skipped, not mixed
+    bool renderNextBlock(const juce::AudioSourceChannelInfo& bufferToFill);
+    // Running totals of where this deck's render time goes; the mixer adds its share
+    DeckLoadStats& getLoadStats() { return loadStats; }
+    // Set by whoever drives the callback: true while a callback may render this deck, false once
+    // none can, e.g. after the device stopped or the deck was taken out of the mix
+    void setAttached(bool isAttached);
 
     bool LoadFile(const juce::File& file);
+    // LoadFile in two halves: prepareTrack is safe on any thread, installTrack is message-thread only
+    std::unique_ptr<PreparedTrack> prepareTrack(const juce::File& file) const;
+    bool installTrack(std::unique_ptr<PreparedTrack> track);
     void goToEnd();
     void play();
+    // Returns at once; the deck fades out and halts when the fade reaches silence
     void stop();
     void Restart();
+    // Message thread: takes over another deck's mix settings (gain, pan, mute, speed,
+    // key lock, loops and fades), e.g. to render a copy of it offline
+    void copySettingsFrom(const PlayerAudio& other);
+    // Length and shape of the fades on play, stop and restart
+    void setTransportFade(double seconds, CrossfadeCurve curve);
+    double getTransportFadeSeconds() const { return parameters.transportFadeSeconds; }
+    CrossfadeCurve getTransportFadeCurve() const { return parameters.transportFadeCurve; }
     void setGain(float gain);
     void setPosition(double pos);
     double getPosition() const;
@@ -26,32 +69,140 @@ public:
     void skipBackward(double seconds);
     void mute();
     void unmute();
+    bool isMuted() const { return parameters.muted; }
+    // Speed changes glide in the render path; safe to call on every slider move
     void setPlaybackRate(float rate);
     float getPlaybackRate() const;
+    // Temporary pitch bend for beat-matching (0.04 = 4% faster), applied on top of the rate; 0 releases it
+    void setNudge(double amount);
+    double getNudge() const { return parameters.nudge; }
+    // Key lock: the playback rate changes tempo only, through a time-stretcher
+    // instead of resampling, so the pitch stays where it is
+    void setKeyLockEnabled(bool shouldLockKey);
+    bool isKeyLockEnabled() const { return keyLockEnabled; }
+    void setTimeStretchQuality(TimeStretchQuality quality);
+    TimeStretchQuality getTimeStretchQuality() const { return parameters.stretchQuality; }
+    // Interpolator for speed changes and sample-rate conversion; trades CPU for fidelity per deck
+    void setResamplerQuality(ResamplerQuality quality);
+    ResamplerQuality getResamplerQuality() const { return parameters.resamplerQuality; }
     void setLoopPointA(double position);
     void setLoopPointB(double position);
     void enableSegmentLoop(bool shouldLoop);
-    bool getSegmentLooping() const { return isSegmentLooping; }
-    void checkSegmentLoop();
-    void setPan(double newPan) { pan = newPan; }
+    bool getSegmentLooping() const { return parameters.segmentLooping; }
+    // Length of the crossfade across the A/B loop seam; 0 jumps back to A with a hard cut
+    void setSeamCrossfade(double seconds);
+    double getSeamCrossfade() const { return seamCrossfadeSeconds; }
+    void setPan(double newPan);
+    // Message thread; the position being heard right now, interpolated between blocks and
+    // behind getPosition() by the output latency. Falls back to getPosition() with no callback running.
+    double getHeardPosition();
+    // Any thread; the device's output latency, which the heard position allows for
+    void setOutputLatency(double seconds) { playheadClock.setOutputLatency(seconds); }
+    // Reflects the audio thread, so a play() shows up here after the next block
     bool isPlaying() const;
     double pendingRestorePosition = -1.0;
 
+    // Read-ahead streaming: when enabled, decoding runs on the shared reader thread
+    void setReadAheadEnabled(bool shouldReadAhead);
+    bool isReadAheadEnabled() const { return readAheadEnabled; }
+    void setReadAheadBufferSize(int numSamples);
+    int getReadAheadBufferSize() const { return readAheadBufferSize; }
+    float getReadAheadFillLevel() const;
+    int getReadAheadUnderruns() const;
+
+    // Memory-mapped fast path for uncompressed files; takes effect by reloading the current track
+    void setMemoryMappingEnabled(bool shouldMap);
+    bool isMemoryMappingEnabled() const { return memoryMappingEnabled; }
+    bool isMemoryMapped() const { return currentTrack != nullptr && currentTrack->prefetcher != nullptr; }
+
+    // The decoded cache is shared by all decks; this only controls whether this deck uses it
+    void setDecodedCacheEnabled(bool shouldUseCache) { decodedCacheEnabled = shouldUseCache; }
+    bool isDecodedCacheEnabled() const { return decodedCacheEnabled; }
+    bool isPlayingFromCache() const { return currentTrack != nullptr && currentTrack->fromCache; }
+    DecodedTrackCache& getTrackCache() { return *trackCache; }
+
+    // Gapless mode: a queued next track starts on the sample after the current one ends.
+    // Tracks at a different sample rate still auto-advance, but with a gap.
+    void setGaplessEnabled(bool shouldBeGapless);
+    bool isGaplessEnabled() const { return gaplessEnabled; }
+    void queueNextTrack(std::unique_ptr<PreparedTrack> track);
+    void clearQueuedTrack();
+    bool hasQueuedTrack() const { return queuedTrack != nullptr; }
+    std::function<void()> onTrackAdvanced;  // message thread, after an automatic advance
+
+    // Crossfade: with a non-zero length the queued track fades in over the end of the
+    // current one instead of following it gaplessly
+    void setCrossfade(double seconds, CrossfadeCurve curve) { sourceChain.setCrossfade(seconds, curve); }
+    double getCrossfadeSeconds() const { return sourceChain.getCrossfadeSeconds(); }
+    CrossfadeCurve getCrossfadeCurve() const { return sourceChain.getCrossfadeCurve(); }
+    // Starts the crossfade into the queued track right away; false if nothing can fade in
+    bool crossfadeToQueuedTrack();
+
+    const juce::AudioFormatReader* getCurrentReader() const;
+    juce::File getCurrentFile() const { return currentTrack != nullptr ? currentTrack->file : juce::File(); }
+
     juce::String getFormattedPosition() const;
 
 private:
     juce::AudioFormatManager formatManager;
-    std::unique_ptr<juce::AudioFormatReaderSource> readerSource;
+    juce::SharedResourcePointer<SharedReadAheadThread> readAheadThread;
+    juce::SharedResourcePointer<DecodedTrackCache> trackCache;
+    std::unique_ptr<LoadedTrack> currentTrack;
+    std::unique_ptr<LoadedTrack> queuedTrack;
+    std::unique_ptr<LoadedTrack> fadingOutTrack;  // previous track while the chain fades it out
+    GaplessSourceChain sourceChain{ *this };
+    TimedSource decodeTimer{ sourceChain };
+    SegmentLoopSource segmentLoop{ decodeTimer };
+    TimeStretchSource timeStretch{ segmentLoop };
+    VarispeedSource varispeed{ timeStretch };
     juce::AudioTransportSource transportSource;
+    GainRamp transportFade;  // audio thread
+    GainPanStage gainPan;     // audio thread
+    DeckLoadStats loadStats;
+    PlayheadClock playheadClock;
+    double deviceSampleRate = 0.0;  // audio thread
+    double playheadSpeed = 0.0;     // audio thread, smoothed over blocks
     bool islooping = false;
-    float previousGain = 0.5f;
-    bool isMuted = false;
     float playbackRate = 1.0f;
-    double pointA = -1.0;
-    double pointB = -1.0;
-    bool isSegmentLooping = false;
-    double pan = 0.5;
+    bool keyLockEnabled = false;
+    double seamCrossfadeSeconds = 0.005;
+
+    // Transport actions and continuous parameters reach the audio thread only through
+    // these, so the message thread never writes state the callback reads. While no
+    // callback can be rendering the deck they are applied on the spot instead.
+    DeckCommands commands;
+    ParameterSnapshot<DeckParameters> parameterSnapshot;
+    DeckParameters parameters;        // message thread's copy
+    DeckParameters audioParameters;   // audio thread's copy
+    std::atomic<juce::uint32> trackGeneration{ 0 };
+    std::atomic<bool> running{ false };  // written by whichever thread applies commands
+    std::atomic<bool> attached{ false };  // a callback may be rendering the deck
+    // Held by every reader of commands and parameterSnapshot except the callback: while the
+    // deck is detached, the message thread and the thread detaching it could both apply them.
+    // Never taken by the callback, which only runs while the deck is attached.
+    juce::CriticalSection detachedLock;
+    bool readAheadEnabled = true;
+    int readAheadBufferSize = 65536;
+    bool memoryMappingEnabled = true;
+    bool decodedCacheEnabled = true;
+    bool gaplessEnabled = true;
+    bool queuedInChain = false;  // queuedTrack was handed to sourceChain for a seamless switch
 
+    std::unique_ptr<LoadedTrack> createLoadedTrack(std::unique_ptr<PreparedTrack> prepared);
+    void buildReadAhead(LoadedTrack& track);
+    void attachSource();
+    void reattachSource();
+    void updateSpeedParameters();
+    juce::MemoryMappedAudioFormatReader* createMappedReader(const juce::File& file) const;
+    void updatePrefetchLoopPoints();
+    juce::int64 secondsToSourceSamples(double seconds) const;
+    void pushCommand(DeckCommand::Type type, juce::int64 position = 0);
+    void publishParameters();
+    void applyPendingChanges();
+    void applyAudioParameters();
+    void publishPlayhead(juce::uint32 generation, juce::int64 startTicks, juce::int64 startSample, juce::int64 endSample, int numSamples);
+    void handleAsyncUpdate() override;
+    void changeListenerCallback(juce::ChangeBroadcaster* source) override;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PlayerAudio)
 };
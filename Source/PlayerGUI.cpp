@@ -38,16 +38,19 @@ void PlayerGUI::MarkersListBoxModel::listBoxItemDoubleClicked(int row, const juc
     {
         parent.playerAudio.setPosition(markersArray[row].position);
         parent.playerAudio.play();
+        parent.refreshScheduler.requestRefresh();
     }
 }
 
-PlayerGUI::PlayerGUI(const juce::String& name)
-    : slotName(name) {  
+PlayerGUI::PlayerGUI(PlayerAudio& audio, const juce::String& name)
+    : playerAudio(audio), slotName(name) {  
     markersListBoxModel = std::make_unique<MarkersListBoxModel>(markers, *this);
 
     markersListBox.setModel(markersListBoxModel.get());
     addAndMakeVisible(markersListBox);
 
+    playerAudio.onTrackAdvanced = [this] { handleTrackAdvanced(); };
+
     auto makeIconButton = [&](std::unique_ptr<juce::DrawableButton>& btn,
         const juce::String& name,
         const juce::String& fileName)
@@ -122,11 +125,31 @@ PlayerGUI::PlayerGUI(const juce::String& name)
     speedLabel.setText("Speed", juce::dontSendNotification);
     speedLabel.setJustificationType(juce::Justification::centred);
     addAndMakeVisible(speedLabel);
-    progressSlider.setRange(0.0, 1.0);
-    progressSlider.setSliderStyle(juce::Slider::LinearHorizontal);
-    progressSlider.setTextBoxStyle(juce::Slider::NoTextBox, false, 0, 0);
-    addAndMakeVisible(progressSlider);
-    progressSlider.addListener(this);
+    keyLockToggle.onClick = [this] { playerAudio.setKeyLockEnabled(keyLockToggle.getToggleState()); };
+    addAndMakeVisible(keyLockToggle);
+    stretchQualityBox.addItem("Low", 1);
+    stretchQualityBox.addItem("Medium", 2);
+    stretchQualityBox.addItem("High", 3);
+    stretchQualityBox.setSelectedId(2, juce::dontSendNotification);
+    stretchQualityBox.onChange = [this]
+        {
+            static const TimeStretchQuality qualities[] = { TimeStretchQuality::low, TimeStretchQuality::medium, TimeStretchQuality::high };
+            playerAudio.setTimeStretchQuality(qualities[juce::jlimit(0, 2, stretchQualityBox.getSelectedItemIndex())]);
+        };
+    addAndMakeVisible(stretchQualityBox);
+    // hold to bend the tempo for beat-matching; releasing snaps back to the slider speed
+    nudgeDownButton.onStateChange = [this] { playerAudio.setNudge(nudgeDownButton.isDown() ? -0.04 : 0.0); };
+    nudgeUpButton.onStateChange = [this] { playerAudio.setNudge(nudgeUpButton.isDown() ? 0.04 : 0.0); };
+    addAndMakeVisible(nudgeDownButton);
+    addAndMakeVisible(nudgeUpButton);
+    waveform.onSeek = [this](double fraction)
+        {
+            double length = playerAudio.getLength();
+            if (length > 0.0)
+                playerAudio.setPosition(fraction * length);
+            refreshScheduler.requestRefresh();
+        };
+    addAndMakeVisible(waveform);
     panSlider.setRange(0.0, 1.0);
     panSlider.setValue(0.5);
     panSlider.setTextValueSuffix(" Pan");
@@ -137,6 +160,18 @@ PlayerGUI::PlayerGUI(const juce::String& name)
     panLabel.setText("Pan", juce::dontSendNotification);
     panLabel.setJustificationType(juce::Justification::centred);
     addAndMakeVisible(panLabel);
+    crossfadeSlider.setRange(0.0, 10.0, 0.5);
+    crossfadeSlider.setValue(0.0);
+    crossfadeSlider.setTextValueSuffix(" s Crossfade");
+    crossfadeSlider.setSliderStyle(juce::Slider::LinearHorizontal);
+    crossfadeSlider.addListener(this);
+    addAndMakeVisible(crossfadeSlider);
+    crossfadeCurveBox.addItem("Linear", 1);
+    crossfadeCurveBox.addItem("Equal power", 2);
+    crossfadeCurveBox.addItem("S-curve", 3);
+    crossfadeCurveBox.setSelectedId(2, juce::dontSendNotification);
+    crossfadeCurveBox.onChange = [this] { sliderValueChanged(&crossfadeSlider); };
+    addAndMakeVisible(crossfadeCurveBox);
     addAndMakeVisible(timeLabel);
     addAndMakeVisible(metadataLabel);
     addAndMakeVisible(markerNameInput);
@@ -146,14 +181,15 @@ PlayerGUI::PlayerGUI(const juce::String& name)
     metadataLabel.setText("No file loaded", juce::dontSendNotification);
     metadataLabel.setColour(juce::Label::textColourId, juce::Colours::white);
     metadataLabel.setJustificationType(juce::Justification::centred);
-    startTimer(10);
     loadLastSession();
+    refreshScheduler.requestRefresh();
     // playlist box
     addAndMakeVisible(playlistBox);
     playlistBox.setModel(this);
     playlistBox.setMultipleSelectionEnabled(false);
     playlistBox.setRowHeight(24);
     playlistBox.setVisible(playlistVisible);
+    library->addChangeListener(this);
 
     makeIconButton(playButton, "Play", "play.svg");
     makeIconButton(stopButton, "Stop", "stop.svg");
@@ -177,9 +213,17 @@ PlayerGUI::PlayerGUI(const juce::String& name)
 }
 
 PlayerGUI::~PlayerGUI() {
+    library->removeChangeListener(this);
     saveLastSession();
 }
 
+void PlayerGUI::changeListenerCallback(juce::ChangeBroadcaster*)
+{
+    // newly indexed tracks show their tags and length
+    playlist.clearRowText();
+    playlistBox.repaint();
+}
+
 void PlayerGUI::prepareToPlay(int samplesPerBlockExpected, double sampleRate)
 {
     playerAudio.prepareToPlay(samplesPerBlockExpected, sampleRate);
@@ -198,18 +242,10 @@ void PlayerGUI::releaseResources()
 
 void PlayerGUI::sliderValueChanged(juce::Slider* slider)
 {
+    refreshScheduler.requestRefresh();
+
     if (slider == &volumeSlider)
         playerAudio.setGain((float)slider->getValue());
-    else if (slider == &progressSlider)
-    {
-
-        double length = playerAudio.getLength();
-        if (length > 0.0)
-        {
-            double newPos = progressSlider.getValue() * length;
-            playerAudio.setPosition(newPos);
-        }
-    }
     else if (slider == &speedSlider)
     {
         playerAudio.setPlaybackRate((float)slider->getValue());
@@ -218,6 +254,12 @@ void PlayerGUI::sliderValueChanged(juce::Slider* slider)
     {
         playerAudio.setPan((float)slider->getValue());
     }
+    else if (slider == &crossfadeSlider)
+    {
+        static const CrossfadeCurve curves[] = { CrossfadeCurve::linear, CrossfadeCurve::equalPower, CrossfadeCurve::sCurve };
+        int curveIndex = juce::jlimit(0, 2, crossfadeCurveBox.getSelectedItemIndex());
+        playerAudio.setCrossfade(crossfadeSlider.getValue(), curves[curveIndex]);
+    }
 
 }
 void PlayerGUI::resized()
@@ -288,11 +330,17 @@ void PlayerGUI::resized()
 
     // الـ Sliders — بدون تغيير
     volumeSlider.setBounds(controlsX, afterButtonsY, controlsW, 30);
-    progressSlider.setBounds(controlsX, afterButtonsY + 40, controlsW, 20);
-    speedLabel.setBounds(controlsX, afterButtonsY + 70, controlsW, 20);
-    speedSlider.setBounds(controlsX, afterButtonsY + 85, controlsW, 25);
+    waveform.setBounds(controlsX, afterButtonsY + 40, controlsW, 20);
+    speedLabel.setBounds(controlsX + 110, afterButtonsY + 65, controlsW - 220, 20);
+    keyLockToggle.setBounds(controlsX, afterButtonsY + 65, 100, 20);
+    stretchQualityBox.setBounds(controlsX + controlsW - 100, afterButtonsY + 65, 100, 20);
+    nudgeDownButton.setBounds(controlsX, afterButtonsY + 85, 40, 25);
+    speedSlider.setBounds(controlsX + 45, afterButtonsY + 85, controlsW - 90, 25);
+    nudgeUpButton.setBounds(controlsX + controlsW - 40, afterButtonsY + 85, 40, 25);
     panLabel.setBounds(controlsX, afterButtonsY + 110, controlsW, 20);
     panSlider.setBounds(controlsX, afterButtonsY + 120, controlsW, 25);
+    crossfadeSlider.setBounds(controlsX, afterButtonsY + 150, controlsW - 130, 25);
+    crossfadeCurveBox.setBounds(controlsX + controlsW - 120, afterButtonsY + 150, 120, 25);
     timeLabel.setBounds(controlsX, afterButtonsY + 50, controlsW, 25);
 
 }
@@ -301,48 +349,51 @@ void PlayerGUI::resized()
 
 void PlayerGUI::buttonClicked(juce::Button* button)
 {
+    // every button either moves the transport or may do so once a file is chosen
+    refreshScheduler.requestRefresh();
+
     if (button == loadButton.get())
     {
         fileChooser = std::make_unique<juce::FileChooser>(
-            "Select an audio file...",
+            "Select audio files or a folder...",
             juce::File{},
             "*.wav;*.mp3");
 
         fileChooser->launchAsync(
             juce::FileBrowserComponent::openMode |
             juce::FileBrowserComponent::canSelectFiles |
+            juce::FileBrowserComponent::canSelectDirectories |
             juce::FileBrowserComponent::canSelectMultipleItems,
             [this](const juce::FileChooser& fc)
             {
-                auto results = fc.getResults();
-                if (results.size() > 0)
+                juce::Array<juce::File> files;
+
+                for (const auto& f : fc.getResults())
                 {
-                    for (const auto& f : results)
+                    if (f.existsAsFile())
                     {
-                        if (f.existsAsFile())
-                            playlist.add(f);
+                        files.add(f);
                     }
-
-                    playlistBox.updateContent();
-
-                    // if nothing is playing, select and play the first newly added file
-                    if (currentIndex == -1 && playlist.size() > 0)
+                    else if (f.isDirectory())
                     {
-                        currentIndex = 0;
-                        playlistBox.selectRow(currentIndex);
-                        playFileAtIndex(currentIndex);
+                        // walked and indexed in the background; the files join the playlist when found
+                        metadataLabel.setText("Scanning " + f.getFileName() + "...", juce::dontSendNotification);
+                        library->scanFolder(f, [safeThis = juce::Component::SafePointer<PlayerGUI>(this)](juce::Array<juce::File> found)
+                            {
+                                if (safeThis != nullptr)
+                                    safeThis->addToPlaylist(found);
+                            });
                     }
-
-                    // update metadata label simply with count
-                    metadataLabel.setText(juce::String(playlist.size()) + " file(s) in playlist", juce::dontSendNotification);
                 }
+
+                library->scanFiles(files);
+                addToPlaylist(files);
             });
 
     }
     else if (button == restartButton.get())
     {
-        playerAudio.setPosition(0.0);
-        playerAudio.play();
+        playerAudio.Restart();
         playButton->setColour(juce::TextButton::buttonColourId, juce::Colours::green);
         stopButton->setColour(juce::TextButton::buttonColourId, juce::Colours::grey);
     }
@@ -409,6 +460,10 @@ void PlayerGUI::buttonClicked(juce::Button* button)
 
     else if (button == nextTrackButton.get())
     {
+        // fade into the preloaded next track; handleTrackAdvanced moves the selection
+        if (playerAudio.crossfadeToQueuedTrack())
+            return;
+
         if (playlist.size() > 0)
         {
             currentIndex = (currentIndex + 1 + playlist.size()) % playlist.size();
@@ -456,7 +511,7 @@ void PlayerGUI::buttonClicked(juce::Button* button)
             markersListBox.updateContent();
             markersListBox.selectRow(markers.size() - 1);
             markerNameInput.clear();
-            saveLastSession();
+            sessionJournal.addMarker(markerText, currentPos);
         }
         else
         {
@@ -468,97 +523,193 @@ void PlayerGUI::buttonClicked(juce::Button* button)
     {
         markers.clear();
         markersListBox.updateContent();
-        saveLastSession();
+        sessionJournal.clearMarkers();
     }
     resized();
 
 }
 
 
-void PlayerGUI::timerCallback()
+bool PlayerGUI::refreshDisplay()
 {
-    topPlayerCurrentFile = playlist.size() > 0 && currentIndex >= 0 ? playlist[currentIndex] : juce::File();
-    topPlayerPosition = playerAudio.getPosition();
+    // covers every way a track arrives: the loader, the session, gapless advance
+    waveform.setFile(playerAudio.getCurrentFile());
+
+    // what is being heard, which moves smoothly between audio blocks
+    const double position = playerAudio.getHeardPosition();
+    const double length = playerAudio.getLength();
+    if (length > 0.0)
+        waveform.setPlayhead(position / length);
 
+    // the label only shows whole seconds; skip the text layout and repaint when they have not moved
+    const int positionSeconds = (int)position;
+    const int lengthSeconds = (int)length;
+    const bool labelChanged = positionSeconds != shownPositionSeconds || lengthSeconds != shownLengthSeconds;
 
-    if (!progressSlider.isMouseButtonDown()) {
-        progressSlider.setValue(playerAudio.getPosition() / playerAudio.getLength(), juce::dontSendNotification);
+    if (labelChanged)
+    {
+        auto toTime = [](int s) { return juce::String::formatted("%02d:%02d", s / 60, s % 60); };
+
+        timeLabel.setText(toTime(positionSeconds) + " / " + toTime(lengthSeconds), juce::dontSendNotification);
+        shownPositionSeconds = positionSeconds;
+        shownLengthSeconds = lengthSeconds;
     }
-    auto toTime = [](double s)
-        {
-            int m = (int)(s / 60);
-            int sec = (int)(fmod(s, 60.0));
-            return juce::String::formatted("%02d:%02d", m, sec);
-        };
 
-    timeLabel.setText(toTime(playerAudio.getPosition()) + " / " + toTime(playerAudio.getLength()), juce::dontSendNotification);
+    return playerAudio.isPlaying() || labelChanged;
 }
 
 
+void PlayerGUI::addToPlaylist(const juce::Array<juce::File>& files)
+{
+    if (files.isEmpty())
+        return;
+
+    // only the tracks that were not listed yet go into the journal
+    const int previousSize = playlist.size();
+    std::vector<SessionState::Entry> added;
+
+    for (auto& file : files)
+        if (playlist.add(file) >= previousSize)
+            added.push_back({ file.getFullPathName(), 0.0 });
+
+    sessionJournal.addTracks(added);
+    playlistBox.updateContent();
+
+    // if nothing is playing, select and play the first newly added file
+    if (currentIndex == -1 && playlist.size() > 0)
+    {
+        currentIndex = 0;
+        playlistBox.selectRow(currentIndex);
+        playFileAtIndex(currentIndex);
+    }
+
+    // update metadata label simply with count
+    metadataLabel.setText(juce::String(playlist.size()) + " file(s) in playlist", juce::dontSendNotification);
+}
+
 void PlayerGUI::playFileAtIndex(int index)
 {
     if (index < 0 || index >= playlist.size())
         return;
 
-    const juce::File& file = playlist[index];
+    const juce::File file = playlist.getFile(index);
+    currentIndex = index;
+    playlistBox.selectRow(currentIndex);
+    metadataLabel.setText("Loading: " + file.getFileName(), juce::dontSendNotification);
+    preloadLoader.cancelPending();
 
-    if (playerAudio.LoadFile(file))
+    // the reader is opened on the loader thread; rapid next/prev presses only deliver the last one
+    trackLoader.loadAsync(file, [this, file](std::unique_ptr<PreparedTrack> track, double totalMilliseconds)
+        {
+            onTrackLoaded(file, std::move(track), totalMilliseconds);
+        });
+}
+
+void PlayerGUI::onTrackLoaded(const juce::File& file, std::unique_ptr<PreparedTrack> track, double totalMilliseconds)
+{
+    if (track == nullptr)
+    {
+        metadataLabel.setText("Failed to load: " + file.getFileName(), juce::dontSendNotification);
+        return;
+    }
+
+    // read everything the label needs before the reader is handed to the transport
+    juce::String info = describeTrack(file, lookUpTrack(file, *track->reader, !track->fromCache));
+    double openMilliseconds = track->openMilliseconds;
+
+    if (playerAudio.installTrack(std::move(track)))
     {
-        currentIndex = index;
-        playlistBox.selectRow(currentIndex);
         playerAudio.play();
+        refreshScheduler.requestRefresh();
 
-        // show metadata basic info (filename + length if available)
-        juce::AudioFormatManager fmt;
-        fmt.registerBasicFormats();
-        std::unique_ptr<juce::AudioFormatReader> reader(fmt.createReaderFor(file));
-        if (reader != nullptr)
+        DBG("Loaded " + file.getFileName() + " in " + juce::String(totalMilliseconds, 1)
+            + " ms (open " + juce::String(openMilliseconds, 1) + " ms)");
+        info << "\nLoad time: " << juce::String(totalMilliseconds, 1) << " ms";
+        metadataLabel.setText(info, juce::dontSendNotification);
+        preloadNextTrack();
+    }
+    else
+    {
+        metadataLabel.setText("Failed to load: " + file.getFileName(), juce::dontSendNotification);
+    }
+}
+
+void PlayerGUI::preloadNextTrack()
+{
+    int nextIndex = currentIndex + 1;
+    if (!playerAudio.isGaplessEnabled() || nextIndex <= 0 || nextIndex >= playlist.size())
+        return;
+
+    preloadLoader.loadAsync(playlist.getFile(nextIndex), [this, nextIndex](std::unique_ptr<PreparedTrack> track, double)
         {
-            double duration = reader->lengthInSamples / reader->sampleRate;
-            juce::String info = "File: " + file.getFileName() + "\n";
-            info += "Sample Rate: " + juce::String(reader->sampleRate) + " Hz\n";
-            info += "Channels: " + juce::String(reader->numChannels) + "\n";
-            int totalSeconds = static_cast<int>(duration);
-            int minutes = totalSeconds / 60;
-            int seconds = totalSeconds % 60;
-
-            juce::String durationStr = juce::String::formatted("%d:%02d", minutes, seconds);
-            info += "Duration: " + durationStr + " (mm:ss)";
-            if (reader->metadataValues.size() > 0)
-            {
-                juce::String artist, title, album;
+            // ignore a preload that finished after the user moved elsewhere in the playlist
+            if (track != nullptr && currentIndex + 1 == nextIndex)
+                playerAudio.queueNextTrack(std::move(track));
+        });
+}
 
-                for (auto key : reader->metadataValues.getAllKeys())
-                {
-                    if (key.compareIgnoreCase("artist") == 0 || key.compareIgnoreCase("author") == 0)
-                        artist = reader->metadataValues[key];
-                    else if (key.compareIgnoreCase("title") == 0)
-                        title = reader->metadataValues[key];
-                    else if (key.compareIgnoreCase("album") == 0)
-                        album = reader->metadataValues[key];
-                }
+void PlayerGUI::handleTrackAdvanced()
+{
+    // the deck already switched on the audio thread; just catch the playlist up
+    if (currentIndex + 1 < playlist.size())
+        ++currentIndex;
 
-                info << "\n--- Metadata ---\n";
-                if (title.isNotEmpty())  info << "Title: " << title << "\n";
-                if (artist.isNotEmpty()) info << "Artist: " << artist << "\n";
-                if (album.isNotEmpty())  info << "Album: " << album << "\n";
-            }
-            else
-            {
-                info << "\n(No another metadata found)";
-            }
+    playlistBox.selectRow(currentIndex);
+    refreshScheduler.requestRefresh();
 
-            metadataLabel.setText(info, juce::dontSendNotification);
-        }
-        else
-        {
-            metadataLabel.setText("Loaded: " + file.getFileName(), juce::dontSendNotification);
-        }
+    if (auto* reader = playerAudio.getCurrentReader())
+    {
+        const auto file = playerAudio.getCurrentFile();
+        metadataLabel.setText(describeTrack(file, lookUpTrack(file, *reader, !playerAudio.isPlayingFromCache())),
+            juce::dontSendNotification);
+    }
+
+    preloadNextTrack();
+}
+
+TrackInfo PlayerGUI::lookUpTrack(const juce::File& file, const juce::AudioFormatReader& reader, bool canIndex)
+{
+    TrackInfo info;
+    if (library->find(file, info))
+        return info;
+
+    // the reader is open anyway; a decoded-cache reader no longer knows the file's own format
+    info = TrackInfo::fromReader(reader);
+    if (canIndex)
+        library->add(file, info);
+    return info;
+}
+
+juce::String PlayerGUI::describeTrack(const juce::File& file, const TrackInfo& track)
+{
+    juce::String info = "File: " + file.getFileName() + "\n";
+    info += "Sample Rate: " + juce::String(track.sampleRate) + " Hz\n";
+    info += "Channels: " + juce::String(track.numChannels) + "\n";
+    int totalSeconds = static_cast<int>(track.durationSeconds);
+    int minutes = totalSeconds / 60;
+    int seconds = totalSeconds % 60;
+
+    juce::String durationStr = juce::String::formatted("%d:%02d", minutes, seconds);
+    info += "Duration: " + durationStr + " (mm:ss)";
+    if (track.tags.size() > 0)
+    {
+        juce::String artist = track.getTag("artist");
+        if (artist.isEmpty())
+            artist = track.getTag("author");
+        juce::String title = track.getTag("title");
+        juce::String album = track.getTag("album");
+
+        info << "\n--- Metadata ---\n";
+        if (title.isNotEmpty())  info << "Title: " << title << "\n";
+        if (artist.isNotEmpty()) info << "Artist: " << artist << "\n";
+        if (album.isNotEmpty())  info << "Album: " << album << "\n";
     }
     else
     {
-        metadataLabel.setText("Failed to load: " + file.getFileName(), juce::dontSendNotification);
+        info << "\n(No another metadata found)";
     }
+
+    return info;
 }
 
 int PlayerGUI::getNumRows()
@@ -577,8 +728,43 @@ void PlayerGUI::paintListBoxItem(int row, juce::Graphics& g, int width, int heig
     g.setColour(juce::Colours::white);
     g.setFont(14.0f);
 
-    const juce::String fileName = playlist[row].getFileName();
-    g.drawText(fileName, 4, 0, width - 8, height, juce::Justification::centredLeft);
+    auto& text = getRowText(row);
+
+    if (text.duration.isNotEmpty())
+    {
+        g.drawText(text.duration, 4, 0, width - 8, height, juce::Justification::centredRight);
+        g.drawText(text.name, 4, 0, width - 56, height, juce::Justification::centredLeft, true);
+    }
+    else
+    {
+        g.drawText(text.name, 4, 0, width - 8, height, juce::Justification::centredLeft);
+    }
+}
+
+const PlaylistModel::RowText& PlayerGUI::getRowText(int row)
+{
+    // the index lookup reads the file's size and date, so it is not repeated on every repaint
+    if (auto* cached = playlist.findRowText(row))
+        return *cached;
+
+    const auto file = playlist.getFile(row);
+    TrackInfo info;
+    PlaylistModel::RowText text;
+
+    if (library->find(file, info))
+    {
+        const int seconds = (int)info.durationSeconds;
+        text.name = info.getDisplayName(file);
+        text.duration = juce::String::formatted("%d:%02d", seconds / 60, seconds % 60);
+    }
+    else
+    {
+        // only the rows on screen are indexed on demand; the row repaints once it is
+        library->scanFiles(juce::Array<juce::File>{ file });
+        text.name = playlist.getFileName(row);
+    }
+
+    return playlist.cacheRowText(row, std::move(text));
 }
 
 void PlayerGUI::listBoxItemDoubleClicked(int row, const juce::MouseEvent& e)
@@ -592,8 +778,13 @@ void PlayerGUI::selectedRowsChanged(int lastRowSelected)
     // optional: update metadata preview when selection changes
     if (lastRowSelected >= 0 && lastRowSelected < playlist.size())
     {
-        const juce::File& file = playlist[lastRowSelected];
-        metadataLabel.setText("Selected: " + file.getFileName(), juce::dontSendNotification);
+        const juce::File file = playlist.getFile(lastRowSelected);
+        TrackInfo info;
+
+        if (library->find(file, info))
+            metadataLabel.setText(describeTrack(file, info), juce::dontSendNotification);
+        else
+            metadataLabel.setText("Selected: " + file.getFileName(), juce::dontSendNotification);
     }
 }
 
@@ -607,146 +798,165 @@ void PlayerGUI::paint(juce::Graphics& g)
 }
 
 
-void PlayerGUI::saveLastSession()
+juce::File PlayerGUI::getSessionJournalFile(const juce::String& slot)
 {
-    juce::File sessionFile = juce::File::getSpecialLocation(juce::File::userDocumentsDirectory)
-        .getChildFile("audio_player_session_" + slotName + ".txt");
-
-    juce::String data;
-
-    data << topPlayerCurrentFile.getFullPathName() << "\n"
-        << topPlayerPosition << "\n";
+    return juce::File::getSpecialLocation(juce::File::userDocumentsDirectory)
+        .getChildFile("audio_player_session_" + slot + ".journal");
+}
 
-    data << "---MARKERS---\n";
-    for (const auto& marker : markers)
-    {
-        data << marker.toString() << "\n";
-    }
-    data << "---END_MARKERS---\n";
+juce::File PlayerGUI::getLegacySessionFile(const juce::String& slot)
+{
+    return juce::File::getSpecialLocation(juce::File::userDocumentsDirectory)
+        .getChildFile("audio_player_session_" + slot + ".txt");
+}
 
-    data << "---PLAYLIST---\n";
-    for (int i = 0; i < playlist.size(); ++i)
-    {
-        data << playlist[i].getFullPathName() << "," << playlistPositions[i] << "\n";
-    }
-    data << "---END_PLAYLIST---\n";
+void PlayerGUI::saveLastSession()
+{
+    topPlayerCurrentFile = playlist.size() > 0 && currentIndex >= 0 ? playlist.getFile(currentIndex) : juce::File();
+    topPlayerPosition = playerAudio.getPosition();
 
-    sessionFile.replaceWithText(data);
+    // markers and tracks are journalled as they change; only the playhead is left to record
+    sessionJournal.setCurrent(topPlayerCurrentFile.getFullPathName(), topPlayerPosition);
 }
 
 void PlayerGUI::loadLastSession()
 {
-    juce::File sessionFile = juce::File::getSpecialLocation(juce::File::userDocumentsDirectory)
-        .getChildFile("audio_player_session_" + slotName + ".txt");
+    SessionState state;
 
-    if (sessionFile.existsAsFile())
-    {
-        juce::StringArray allLines;
-        allLines.addLines(sessionFile.loadFileAsString());
+    // sessions saved before the journal are carried over into one, once
+    if (!sessionJournal.load(state) && readLegacySession(state))
+        sessionJournal.rewrite(state);
 
-        int currentLineIndex = 0;
+    applySessionState(state);
+}
 
-        if (allLines.size() > currentLineIndex + 1)
-        {
-            topPlayerCurrentFile = juce::File(allLines[currentLineIndex++]);
-            topPlayerPosition = allLines[currentLineIndex++].getDoubleValue();
+bool PlayerGUI::readLegacySession(SessionState& state) const
+{
+    juce::File sessionFile = getLegacySessionFile(slotName);
 
-            if (topPlayerCurrentFile.existsAsFile())
-            {
-                playerAudio.LoadFile(topPlayerCurrentFile);
-                playerAudio.setPosition(topPlayerPosition);
-                int existingIndex = playlist.indexOf(topPlayerCurrentFile);
+    if (!sessionFile.existsAsFile())
+        return false;
 
-                if (existingIndex == -1)
-                {
-                    playlist.add(topPlayerCurrentFile);
-                    playlistPositions.add(topPlayerPosition);
-                    currentIndex = playlist.size() - 1;
-                }
-                else
-                {
-                    playlistPositions.set(existingIndex, topPlayerPosition);
-                    currentIndex = existingIndex;
-                }
+    juce::StringArray allLines;
+    allLines.addLines(sessionFile.loadFileAsString());
 
+    int currentLineIndex = 0;
 
-                playlistBox.updateContent();
-                playlistBox.selectRow(currentIndex);
-                metadataLabel.setText("Restored: " + topPlayerCurrentFile.getFileName() + " @ " + juce::String(topPlayerPosition, 2) + "s", juce::dontSendNotification);
-                playerAudio.play();
-            }
-        }
+    if (allLines.size() > currentLineIndex + 1)
+    {
+        state.currentFile = allLines[currentLineIndex++];
+        state.currentPosition = allLines[currentLineIndex++].getDoubleValue();
+    }
 
-        bool foundMarkersSection = false;
-        while (currentLineIndex < allLines.size())
+    bool foundMarkersSection = false;
+    while (currentLineIndex < allLines.size())
+    {
+        if (allLines[currentLineIndex] == "---MARKERS---")
         {
-            if (allLines[currentLineIndex] == "---MARKERS---")
-            {
-                foundMarkersSection = true;
-                currentLineIndex++;
-                break;
-            }
+            foundMarkersSection = true;
             currentLineIndex++;
+            break;
         }
+        currentLineIndex++;
+    }
 
-        if (foundMarkersSection)
+    if (foundMarkersSection)
+    {
+        while (currentLineIndex < allLines.size() && allLines[currentLineIndex] != "---END_MARKERS---")
         {
-            while (currentLineIndex < allLines.size() && allLines[currentLineIndex] != "---END_MARKERS---")
+            juce::String line = allLines[currentLineIndex++];
+            if (!line.isEmpty())
             {
-                juce::String line = allLines[currentLineIndex++];
-                if (!line.isEmpty())
-                {
-                    markers.add(TrackMarker::fromString(line));
-                }
+                auto marker = TrackMarker::fromString(line);
+                state.markers.push_back({ marker.name, marker.position });
             }
-            markersListBox.updateContent();
         }
+    }
 
-        bool foundPlaylistSection = false;
-        while (currentLineIndex < allLines.size())
+    bool foundPlaylistSection = false;
+    while (currentLineIndex < allLines.size())
+    {
+        if (allLines[currentLineIndex] == "---PLAYLIST---")
         {
-            if (allLines[currentLineIndex] == "---PLAYLIST---")
-            {
-                foundPlaylistSection = true;
-                currentLineIndex++;
-                break;
-            }
+            foundPlaylistSection = true;
             currentLineIndex++;
+            break;
         }
+        currentLineIndex++;
+    }
 
-        if (foundPlaylistSection)
+    if (foundPlaylistSection)
+    {
+        state.tracks.reserve((size_t)(allLines.size() - currentLineIndex));
+
+        while (currentLineIndex < allLines.size() && allLines[currentLineIndex] != "---END_PLAYLIST---")
         {
-            while (currentLineIndex < allLines.size() && allLines[currentLineIndex] != "---END_PLAYLIST---")
+            juce::String line = allLines[currentLineIndex++];
+            if (!line.isEmpty())
             {
-                juce::String line = allLines[currentLineIndex++];
-                if (!line.isEmpty())
-                {
-                    juce::StringArray parts;
-                    parts.addTokens(line, ",", "");
-                    if (parts.size() == 2)
-                    {
-                        juce::File playlistFile(parts[0]);
-                        double playlistFilePosition = parts[1].getDoubleValue();
-                        if (playlistFile.existsAsFile())
-                        {
-                            int existingIndex = playlist.indexOf(playlistFile);
-                            if (existingIndex == -1)
-                            {
-                                playlist.add(playlistFile);
-                                playlistPositions.add(playlistFilePosition);
-                            }
-                        }
-                    }
-                }
+                juce::StringArray parts;
+                parts.addTokens(line, ",", "");
+                if (parts.size() == 2)
+                    state.tracks.push_back({ parts[0], parts[1].getDoubleValue() });
             }
+        }
+    }
+
+    return true;
+}
+
+void PlayerGUI::applySessionState(const SessionState& state)
+{
+    if (state.currentFile.isNotEmpty())
+    {
+        topPlayerCurrentFile = juce::File(state.currentFile);
+        topPlayerPosition = state.currentPosition;
+
+        if (topPlayerCurrentFile.existsAsFile())
+        {
+            playerAudio.LoadFile(topPlayerCurrentFile);
+            playerAudio.setPosition(topPlayerPosition);
+            currentIndex = playlist.add(topPlayerCurrentFile);
+            playlist.setPosition(currentIndex, topPlayerPosition);
+
+
             playlistBox.updateContent();
-            if (currentIndex == -1 && playlist.size() > 0)
-            {
-                currentIndex = 0;
-                playlistBox.selectRow(currentIndex);
-            }
+            playlistBox.selectRow(currentIndex);
+            metadataLabel.setText("Restored: " + topPlayerCurrentFile.getFileName() + " @ " + juce::String(topPlayerPosition, 2) + "s", juce::dontSendNotification);
+            playerAudio.play();
+            refreshScheduler.requestRefresh();
         }
     }
+
+    if (!state.markers.empty())
+    {
+        for (auto& marker : state.markers)
+            markers.add({ marker.text, marker.position });
+
+        markersListBox.updateContent();
+    }
+
+    if (!state.tracks.empty())
+    {
+        playlist.reserve(playlist.size() + (int)state.tracks.size());
+
+        for (auto& track : state.tracks)
+        {
+            juce::File playlistFile(track.text);
+            // an entry already listed keeps its position
+            if (playlistFile.existsAsFile())
+                playlist.add(playlistFile, track.position);
+        }
+
+        playlistBox.updateContent();
+        if (currentIndex == -1 && playlist.size() > 0)
+        {
+            currentIndex = 0;
+            playlistBox.selectRow(currentIndex);
+        }
+    }
+
+    preloadNextTrack();
 }
 
 
@@ -11,6 +11,12 @@
 #pragma once
 #include <JuceHeader.h>
 #include "PlayerAudio.h"
+#include "AsyncTrackLoader.h"
+#include "WaveformDisplay.h"
+#include "RefreshScheduler.h"
+#include "LibraryIndex.h"
+#include "PlaylistModel.h"
+#include "SessionJournal.h"
 struct TrackMarker
 {
     double position = 0.0;
@@ -52,14 +58,13 @@ class PlayerGUI : public juce::Component,
     public juce::Button::Listener,
     public juce::Slider::Listener,
     public juce::ListBoxModel,
-    public juce::Timer
-
+    private juce::ChangeListener
 {
 public:
     ~PlayerGUI() override;
-    PlayerAudio playerAudio;
+    PlayerAudio& playerAudio;  // owned by whoever mixes it, and outlives this
 
-    PlayerGUI(const juce::String& name = "default");
+    PlayerGUI(PlayerAudio& audio, const juce::String& name = "default");
     void prepareToPlay(int samplesPerBlockExpected, double sampleRate);
     void getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill);
     void releaseResources();
@@ -68,7 +73,6 @@ public:
     void resized() override;
     juce::File topPlayerCurrentFile;
     double topPlayerPosition = 0.0;
-    juce::Array<double> playlistPositions;
 
     // ListBoxModel overrides (playlist)
     int getNumRows() override;
@@ -77,8 +81,14 @@ public:
     void selectedRowsChanged(int lastRowSelected) override;
     void saveLastSession();
     void loadLastSession();
+    // The session journal, and the text file sessions were kept in before it
+    static juce::File getSessionJournalFile(const juce::String& slot);
+    static juce::File getLegacySessionFile(const juce::String& slot);
+    // The journal saveLastSession queues into, e.g. to wait for it to reach the disk
+    SessionJournal& getSessionJournal() { return sessionJournal; }
 private:
     juce::String slotName;
+    SessionJournal sessionJournal{ getSessionJournalFile(slotName) };
 
     std::unique_ptr<juce::DrawableButton> playButton, stopButton, restartButton,
         muteButton, unmuteButton, nextTrackButton, prevTrackButton,
@@ -87,11 +97,16 @@ private:
 
     juce::Slider speedSlider;
     juce::Label speedLabel;
+    juce::ToggleButton keyLockToggle{ "Key lock" };
+    juce::TextButton nudgeDownButton{ "<" }, nudgeUpButton{ ">" };
+    juce::ComboBox stretchQualityBox;
     juce::Label metadataLabel;
     juce::Slider volumeSlider;
-    juce::Slider progressSlider;
+    WaveformDisplay waveform;  // the track overview doubles as the progress bar
     juce::Slider panSlider;
     juce::Label panLabel;
+    juce::Slider crossfadeSlider;
+    juce::ComboBox crossfadeCurveBox;
     juce::Label timeLabel;
     std::unique_ptr<juce::FileChooser> fileChooser;
     juce::Array<TrackMarker> markers;
@@ -119,16 +134,36 @@ private:
 
     bool playlistVisible = true;
     juce::ListBox playlistBox;
-    juce::Array<juce::File> playlist;
+    PlaylistModel playlist;
+    juce::SharedResourcePointer<LibraryIndex> library;
     int currentIndex = -1;
+    AsyncTrackLoader trackLoader{ playerAudio };
+    AsyncTrackLoader preloadLoader{ playerAudio };
 
     bool loopOn = false;
     bool isLoopingAB = false;
     // Event handlers 
     void buttonClicked(juce::Button* button) override;
     void sliderValueChanged(juce::Slider* slider) override;
+    void addToPlaylist(const juce::Array<juce::File>& files);
+    bool readLegacySession(SessionState& state) const;
+    void applySessionState(const SessionState& state);
+    const PlaylistModel::RowText& getRowText(int row);
     void playFileAtIndex(int index);
-    void timerCallback() override;
+    void onTrackLoaded(const juce::File& file, std::unique_ptr<PreparedTrack> track, double totalMilliseconds);
+    void preloadNextTrack();
+    void handleTrackAdvanced();
+    // From the library when indexed, otherwise from the open reader, which then indexes it
+    TrackInfo lookUpTrack(const juce::File& file, const juce::AudioFormatReader& reader, bool canIndex);
+    static juce::String describeTrack(const juce::File& file, const TrackInfo& track);
+    void changeListenerCallback(juce::ChangeBroadcaster* source) override;
+    // Brings the playhead and time label up to date; true while they can still change
+    bool refreshDisplay();
+
+    // redraws on the display's vblank while the deck plays or a change settles, never when idle
+    RefreshScheduler refreshScheduler{ *this, [this] { return refreshDisplay(); } };
+    int shownPositionSeconds = -1;
+    int shownLengthSeconds = -1;
    
    
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PlayerGUI)
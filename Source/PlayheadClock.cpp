@@ -0,0 +1,46 @@
+/*
+  ==============================================================================
+
+    PlayheadClock.cpp
+    Created: 18 Oct 2026 6:20:33am
+
+  ==============================================================================
+*/
+
+#include "PlayheadClock.h"
+
+namespace
+{
+    constexpr double staleSeconds = 0.5;    // no block for this long: the callback is not running the deck
+    constexpr double maxJitterSeconds = 0.1; // a step back further than this is a seek or a loop, not jitter
+}
+
+double PlayheadClock::getHeardPosition(juce::uint32 generation)
+{
+    snapshot.fetch(latest);
+
+    if (latest.hostTicks == 0 || latest.generation != generation)
+    {
+        lastHeard = -1.0;
+        return -1.0;
+    }
+
+    const double sinceBlock = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - latest.hostTicks);
+    if (sinceBlock > staleSeconds)
+    {
+        lastHeard = -1.0;
+        return -1.0;
+    }
+
+    // never run ahead of what has been rendered, in case the next callback is late
+    const double elapsed = juce::jmin(sinceBlock, 2.0 * latest.blockSeconds) - outputLatency.load();
+    double heard = juce::jmax(0.0, latest.position + elapsed * latest.speed);
+
+    // each block's timestamp carries a little scheduling jitter; while playing, hold
+    // the playhead rather than let it twitch backwards by it
+    if (latest.speed > 0.0 && heard < lastHeard && lastHeard - heard < maxJitterSeconds)
+        heard = lastHeard;
+
+    lastHeard = heard;
+    return heard;
+}
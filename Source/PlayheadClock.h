@@ -0,0 +1,52 @@
+/*
+  ==============================================================================
+
+    PlayheadClock.h
+    Created: 18 Oct 2026 6:20:33am
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "DeckControl.h"
+
+// Where a deck's rendering stood at the start of a block, and when
+struct PlayheadState
+{
+    double position = 0.0;         // seconds into the track
+    double speed = 0.0;            // track seconds per second of output; 0 while stopped
+    juce::int64 hostTicks = 0;     // Time::getHighResolutionTicks() when the block was rendered
+    double blockSeconds = 0.0;
+    juce::uint32 generation = 0;   // the track it belongs to
+};
+
+// Hands a deck's playhead from the audio thread to the GUI without either side
+// waiting. The audio thread publishes one state per block; the reader extrapolates
+// from the newest one to the current time and subtracts the output latency, so
+// the position it reports moves smoothly and is the one being heard, however
+// large the blocks are.
+class PlayheadClock
+{
+public:
+    // Audio thread, once per block
+    void publish(const PlayheadState& state) { snapshot.publish(state); }
+
+    // Any thread; time between a block being rendered and its first sample leaving the speakers
+    void setOutputLatency(double seconds) { outputLatency = juce::jmax(0.0, seconds); }
+    double getOutputLatency() const { return outputLatency; }
+
+    // Reader thread only; the position being heard now, or -1 if the audio thread has
+    // not rendered the given track lately (no device running, or a new track not yet started)
+    double getHeardPosition(juce::uint32 generation);
+
+private:
+    ParameterSnapshot<PlayheadState> snapshot;
+    std::atomic<double> outputLatency{ 0.0 };
+
+    // reader's copies
+    PlayheadState latest;
+    double lastHeard = -1.0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PlayheadClock)
+};
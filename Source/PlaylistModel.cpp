@@ -0,0 +1,144 @@
+/*
+  ==============================================================================
+
+    PlaylistModel.cpp
+    Created: 18 Oct 2026 7:48:20am
+
+  ==============================================================================
+*/
+
+#include "PlaylistModel.h"
+
+void PlaylistModel::splitPath(const juce::String& path, juce::String& folder, juce::String& name)
+{
+    const int split = path.lastIndexOfChar(juce::File::getSeparatorChar()) + 1;
+    folder = path.substring(0, split);
+    name = path.substring(split);
+}
+
+size_t PlaylistModel::hashName(const juce::String& s)
+{
+    static const bool caseSensitive = juce::File::areFileNamesCaseSensitive();
+    if (caseSensitive)
+        return (size_t)s.hashCode64();
+
+    // folded the way equalsIgnoreCase compares, so names it calls equal hash alike
+    juce::uint64 hash = 0;
+    for (auto t = s.getCharPointer(); !t.isEmpty();)
+        hash = hash * 101 + (juce::uint64)juce::CharacterFunctions::toUpperCase(t.getAndAdvance());
+    return (size_t)hash;
+}
+
+bool PlaylistModel::namesMatch(const juce::String& a, const juce::String& b)
+{
+    static const bool caseSensitive = juce::File::areFileNamesCaseSensitive();
+    return caseSensitive ? a == b : a.equalsIgnoreCase(b);
+}
+
+size_t PlaylistModel::FolderHash::operator()(int id) const
+{
+    return hashName(model->getFolder(id));
+}
+
+bool PlaylistModel::FolderEqual::operator()(int a, int b) const
+{
+    return namesMatch(model->getFolder(a), model->getFolder(b));
+}
+
+size_t PlaylistModel::EntryHash::operator()(int index) const
+{
+    auto& entry = model->getEntry(index);
+    return hashName(entry.name) * 31u + (size_t)entry.folder;
+}
+
+bool PlaylistModel::EntryEqual::operator()(int a, int b) const
+{
+    auto& first = model->getEntry(a);
+    auto& second = model->getEntry(b);
+    return first.folder == second.folder && namesMatch(first.name, second.name);
+}
+
+juce::String PlaylistModel::getPath(int index) const
+{
+    auto& entry = entries[(size_t)index];
+    return folders[entry.folder] + entry.name;
+}
+
+int PlaylistModel::findFolder(const juce::String& folder) const
+{
+    probeFolder = folder;
+    auto it = folderIds.find(probeIndex);
+    return it != folderIds.end() ? *it : -1;
+}
+
+int PlaylistModel::indexOf(const juce::File& file) const
+{
+    juce::String folder, name;
+    splitPath(file.getFullPathName(), folder, name);
+
+    const int folderId = findFolder(folder);
+    if (folderId < 0)
+        return -1;
+
+    probeEntry.folder = folderId;
+    probeEntry.name = name;
+    auto it = entryIndex.find(probeIndex);
+    return it != entryIndex.end() ? *it : -1;
+}
+
+int PlaylistModel::add(const juce::File& file, double position)
+{
+    juce::String folder, name;
+    splitPath(file.getFullPathName(), folder, name);
+
+    int folderId = findFolder(folder);
+    if (folderId < 0)
+    {
+        folderId = folders.size();
+        folders.add(folder);
+        folderIds.insert(folderId);
+    }
+
+    probeEntry.folder = folderId;
+    probeEntry.name = name;
+    auto it = entryIndex.find(probeIndex);
+    if (it != entryIndex.end())
+        return *it;
+
+    const int index = (int)entries.size();
+    entries.push_back({ folderId, name, position });
+    entryIndex.insert(index);
+    return index;
+}
+
+void PlaylistModel::reserve(int numEntries)
+{
+    entries.reserve((size_t)numEntries);
+    entryIndex.reserve((size_t)numEntries);
+}
+
+void PlaylistModel::clear()
+{
+    entries.clear();
+    folders.clear();
+    folderIds.clear();
+    entryIndex.clear();
+    rowTexts.clear();
+    probeFolder = {};
+    probeEntry = {};
+}
+
+const PlaylistModel::RowText* PlaylistModel::findRowText(int index) const
+{
+    auto it = rowTexts.find(index);
+    return it != rowTexts.end() ? &it->second : nullptr;
+}
+
+const PlaylistModel::RowText& PlaylistModel::cacheRowText(int index, RowText text)
+{
+    // scrolling far enough fills it; start over rather than track recency
+    if (rowTexts.size() >= maxRowTexts)
+        rowTexts.clear();
+
+    return rowTexts[index] = std::move(text);
+}
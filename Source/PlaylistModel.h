@@ -0,0 +1,89 @@
+/*
+  ==============================================================================
+
+    PlaylistModel.h
+    Created: 18 Oct 2026 7:48:20am
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <unordered_map>
+#include <unordered_set>
+
+// A deck's playlist, built to stay fast and small at hundreds of thousands of entries.
+// Each track is stored as an interned folder plus its file name, so tracks sharing a
+// folder share one copy of its path; a hash index makes membership checks O(1), and
+// display strings are cached for the rows that are actually being painted.
+// A file appears at most once. Message thread only.
+class PlaylistModel
+{
+public:
+    struct RowText
+    {
+        juce::String name;
+        juce::String duration;  // empty until the track is indexed
+    };
+
+    int size() const { return (int)entries.size(); }
+    bool isEmpty() const { return entries.empty(); }
+
+    juce::File getFile(int index) const { return juce::File(getPath(index)); }
+    juce::String getPath(int index) const;
+    const juce::String& getFileName(int index) const { return entries[(size_t)index].name; }
+    double getPosition(int index) const { return entries[(size_t)index].position; }
+    void setPosition(int index, double position) { entries[(size_t)index].position = position; }
+
+    // -1 if the file is not listed
+    int indexOf(const juce::File& file) const;
+    bool contains(const juce::File& file) const { return indexOf(file) >= 0; }
+    // Appends the file unless it is listed already; returns its index either way
+    int add(const juce::File& file, double position = 0.0);
+    void reserve(int numEntries);
+    void clear();
+
+    // Cached text for a row, or nullptr; kept only for the few hundred rows painted most recently
+    const RowText* findRowText(int index) const;
+    const RowText& cacheRowText(int index, RowText text);
+    // After anything that changes how rows read, e.g. tracks being indexed
+    void clearRowText() { rowTexts.clear(); }
+
+private:
+    struct Entry
+    {
+        int folder = 0;
+        juce::String name;
+        double position = 0.0;
+    };
+
+    // The indexes hold positions in folders and entries, and hash and compare the strings
+    // found there, so no name is ever stored twice. Where the file system ignores case it is
+    // folded as they are read. A lookup fills in the probe and searches for probeIndex.
+    static constexpr int probeIndex = -1;
+
+    struct FolderHash  { const PlaylistModel* model; size_t operator()(int id) const; };
+    struct FolderEqual { const PlaylistModel* model; bool operator()(int a, int b) const; };
+    struct EntryHash   { const PlaylistModel* model; size_t operator()(int index) const; };
+    struct EntryEqual  { const PlaylistModel* model; bool operator()(int a, int b) const; };
+
+    static constexpr size_t maxRowTexts = 512;
+
+    static void splitPath(const juce::String& path, juce::String& folder, juce::String& name);
+    static size_t hashName(const juce::String& s);
+    static bool namesMatch(const juce::String& a, const juce::String& b);
+    const juce::String& getFolder(int id) const { return id == probeIndex ? probeFolder : folders.getReference(id); }
+    const Entry& getEntry(int index) const { return index == probeIndex ? probeEntry : entries[(size_t)index]; }
+    int findFolder(const juce::String& folder) const;
+
+    std::vector<Entry> entries;
+    juce::StringArray folders;  // each ends with a separator
+    std::unordered_set<int, FolderHash, FolderEqual> folderIds{ 0, FolderHash{ this }, FolderEqual{ this } };
+    std::unordered_set<int, EntryHash, EntryEqual> entryIndex{ 0, EntryHash{ this }, EntryEqual{ this } };
+    mutable juce::String probeFolder;  // what a lookup is for
+    mutable Entry probeEntry;
+    std::unordered_map<int, RowText> rowTexts;
+
+    // the indexes point back at this object
+    JUCE_DECLARE_NON_COPYABLE(PlaylistModel)
+};
@@ -0,0 +1,285 @@
+/*
+  ==============================================================================
+
+    ReadAheadAudioSource.cpp
+    Created: 17 Oct 2026 10:02:41am
+
+  ==============================================================================
+*/
+
+#include "ReadAheadAudioSource.h"
+
+namespace
+{
+    constexpr int maxChunkSize = 2048;
+    constexpr int pinnedRegionSize = 32768;
+}
+
+ReadAheadAudioSource::ReadAheadAudioSource(juce::PositionableAudioSource* s,
+    juce::TimeSliceThread& thread,
+    bool deleteSourceWhenDeleted,
+    int bufferSizeSamples,
+    int numChannels)
+    : source(s, deleteSourceWhenDeleted),
+    backgroundThread(thread),
+    numberOfSamplesToBuffer(juce::jmax(4 * maxChunkSize, bufferSizeSamples)),
+    numberOfChannels(numChannels)
+{
+    jassert(source != nullptr);
+}
+
+ReadAheadAudioSource::~ReadAheadAudioSource()
+{
+    releaseResources();
+}
+
+void ReadAheadAudioSource::prepareToPlay(int samplesPerBlockExpected, double sampleRate)
+{
+    // the callback ignores the ring while it is resized; the reader is off until it is primed
+    isPrepared = false;
+    backgroundThread.removeTimeSliceClient(this);
+
+    source->prepareToPlay(samplesPerBlockExpected, sampleRate);
+
+    buffer.setSize(numberOfChannels, juce::jmax(samplesPerBlockExpected * 2, numberOfSamplesToBuffer));
+    buffer.clear();
+    validStart = 0;
+    validEnd = 0;
+    pinned.setSize(numberOfChannels, pinnedRegionSize);
+    pinnedLength = 0;
+
+    scratch.setSize(numberOfChannels, maxChunkSize);
+    loadedPinStart = -1;
+    isPrepared = true;
+
+    // prime the first chunk here, on the caller's thread, so playback can start without a gap
+    readNextBufferChunk();
+    backgroundThread.addTimeSliceClient(this);
+}
+
+void ReadAheadAudioSource::releaseResources()
+{
+    isPrepared = false;
+    backgroundThread.removeTimeSliceClient(this);
+
+    buffer.setSize(numberOfChannels, 0);
+    validStart = 0;
+    validEnd = 0;
+    pinned.setSize(numberOfChannels, 0);
+    pinnedLength = 0;
+
+    scratch.setSize(numberOfChannels, 0);
+    loadedPinStart = -1;
+    source->releaseResources();
+}
+
+void ReadAheadAudioSource::getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill)
+{
+    auto pos = nextPlayPos.load();
+    const auto numSamples = bufferToFill.numSamples;
+    auto& output = *bufferToFill.buffer;
+    const int numOutputChannels = juce::jmin(numberOfChannels, output.getNumChannels());
+
+    // channels the source does not have
+    for (int chan = numOutputChannels; chan < output.getNumChannels(); ++chan)
+        output.clear(chan, bufferToFill.startSample, numSamples);
+
+    if (!isPrepared.load())
+    {
+        output.clear(bufferToFill.startSample, numSamples);
+        nextPlayPos.compare_exchange_strong(pos, pos + numSamples);
+        return;
+    }
+
+    // never wait for the reader thread: take a snapshot of what it has published and copy from that
+    const auto epoch = ringEpoch.load(std::memory_order_acquire);
+    const auto bufferedStart = validStart.load(std::memory_order_acquire);
+    const auto bufferedEnd = validEnd.load(std::memory_order_acquire);
+    const int pinLength = pinnedLength.load(std::memory_order_acquire);
+    const auto pinStart = pinnedStart.load(std::memory_order_acquire);
+
+    // right after a jump to the pinned start the ring is still empty, so play from the copy
+    int pinnedCount = 0;
+    if (pinLength > 0 && pos >= pinStart && pos < pinStart + pinLength
+        && !(pos >= bufferedStart && pos < bufferedEnd))
+    {
+        pinnedCount = (int)juce::jmin((juce::int64)numSamples, pinStart + pinLength - pos);
+
+        for (int chan = numOutputChannels; --chan >= 0;)
+            output.copyFrom(chan, bufferToFill.startSample, pinned, chan, (int)(pos - pinStart), pinnedCount);
+    }
+
+    // the part of the rest of the block that the ring holds
+    const int startOffset = (int)juce::jlimit((juce::int64)pinnedCount, (juce::int64)numSamples, bufferedStart - pos);
+    const int endOffset = (int)juce::jlimit((juce::int64)startOffset, (juce::int64)numSamples, bufferedEnd - pos);
+
+    if (startOffset > pinnedCount)
+        output.clear(bufferToFill.startSample + pinnedCount, startOffset - pinnedCount);
+    if (endOffset < numSamples)
+        output.clear(bufferToFill.startSample + endOffset, numSamples - endOffset);
+
+    if (startOffset < endOffset)
+    {
+        const int size = buffer.getNumSamples();
+        const int ringStart = (int)((pos + startOffset) % size);
+        const int count = endOffset - startOffset;
+        const int firstPart = juce::jmin(count, size - ringStart);
+
+        for (int chan = numOutputChannels; --chan >= 0;)
+        {
+            output.copyFrom(chan, bufferToFill.startSample + startOffset, buffer, chan, ringStart, firstPart);
+            if (firstPart < count)
+                output.copyFrom(chan, bufferToFill.startSample + startOffset + firstPart, buffer, chan, 0, count - firstPart);
+        }
+    }
+
+    // whatever the reader overwrote while we copied is not the audio we asked for
+    std::atomic_thread_fence(std::memory_order_acquire);
+    int copied = pinnedCount + endOffset - startOffset;
+
+    if (ringEpoch.load(std::memory_order_relaxed) != epoch)
+    {
+        output.clear(bufferToFill.startSample, numSamples);
+        copied = 0;
+    }
+    else
+    {
+        const auto reusedBelow = validStart.load(std::memory_order_relaxed);
+        const auto lost = (int)juce::jlimit((juce::int64)0, (juce::int64)(endOffset - startOffset), reusedBelow - pos - startOffset);
+        if (lost > 0)
+        {
+            output.clear(bufferToFill.startSample + startOffset, lost);
+            copied -= lost;
+        }
+    }
+
+    // only silence inside the track counts: running off the end of a non-looping file is not an underrun
+    const auto audibleEnd = isLooping() ? pos + numSamples : juce::jmin(pos + numSamples, getTotalLength());
+    if (copied < audibleEnd - pos)
+        ++underruns;
+
+    // a seek made while this block was copied wins
+    nextPlayPos.compare_exchange_strong(pos, pos + numSamples);
+}
+
+void ReadAheadAudioSource::setNextReadPosition(juce::int64 newPosition)
+{
+    nextPlayPos = newPosition;
+    backgroundThread.moveToFrontOfQueue(this);
+}
+
+juce::int64 ReadAheadAudioSource::getNextReadPosition() const
+{
+    const auto pos = nextPlayPos.load();
+    const auto length = getTotalLength();
+    return (isLooping() && length > 0) ? pos % length : pos;
+}
+
+float ReadAheadAudioSource::getFillLevel() const
+{
+    if (numberOfSamplesToBuffer <= 0)
+        return 0.0f;
+
+    const auto ahead = validEnd.load() - nextPlayPos.load();
+    return juce::jlimit(0.0f, 1.0f, (float)ahead / (float)numberOfSamplesToBuffer);
+}
+
+int ReadAheadAudioSource::useTimeSlice()
+{
+    if (refreshPinnedRegion())
+        return 1;
+
+    return readNextBufferChunk() ? 1 : 100;
+}
+
+bool ReadAheadAudioSource::refreshPinnedRegion()
+{
+    const auto requested = requestedPinStart.load();
+    if (!isPrepared || requested == loadedPinStart)
+        return false;
+
+    // a callback still copying the old audio sees the epoch move and discards it
+    pinnedLength = 0;
+    ringEpoch.fetch_add(1);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    loadedPinStart = requested;
+
+    const int length = (int)juce::jmin((juce::int64)pinned.getNumSamples(), getTotalLength() - requested);
+    if (requested < 0 || length <= 0)
+        return true;
+
+    source->setNextReadPosition(requested);
+    source->getNextAudioBlock(juce::AudioSourceChannelInfo(&pinned, 0, length));
+
+    pinnedStart.store(requested, std::memory_order_release);
+    pinnedLength.store(length, std::memory_order_release);
+    return true;
+}
+
+bool ReadAheadAudioSource::readNextBufferChunk()
+{
+    if (!isPrepared)
+        return false;
+
+    auto bufferedStart = validStart.load(std::memory_order_relaxed);
+    auto bufferedEnd = validEnd.load(std::memory_order_relaxed);
+
+    if (wasSourceLooping != isLooping())
+    {
+        wasSourceLooping = isLooping();
+        bufferedStart = bufferedEnd = 0;
+    }
+
+    const auto newBVS = juce::jmax((juce::int64)0, nextPlayPos.load());
+    auto newBVE = newBVS + buffer.getNumSamples() - 4;
+    juce::int64 sectionStart = 0, sectionEnd = 0;
+
+    if (newBVS < bufferedStart || newBVS >= bufferedEnd)
+    {
+        // playhead left the buffered window (seek or cold start): restart from it. Any slot may
+        // be reused, so a callback copying from the old window must discard what it got.
+        newBVE = juce::jmin(newBVE, newBVS + maxChunkSize);
+        sectionStart = newBVS;
+        sectionEnd = newBVE;
+
+        validEnd.store(newBVS, std::memory_order_relaxed);
+        validStart.store(newBVS, std::memory_order_relaxed);
+        ringEpoch.fetch_add(1);
+    }
+    else if (newBVS - bufferedStart > 512 || newBVE - bufferedEnd > 512)
+    {
+        // the slots reused lie below the playhead, which only moves on once a block is copied
+        newBVE = juce::jmin(newBVE, bufferedEnd + maxChunkSize);
+        sectionStart = bufferedEnd;
+        sectionEnd = newBVE;
+
+        validStart.store(newBVS, std::memory_order_relaxed);
+    }
+
+    if (sectionStart >= sectionEnd)
+        return false;
+
+    std::atomic_thread_fence(std::memory_order_release);
+
+    // the disk read and the copy into the ring both happen without anything the callback waits on
+    const int length = (int)(sectionEnd - sectionStart);
+    if (source->getNextReadPosition() != sectionStart)
+        source->setNextReadPosition(sectionStart);
+
+    source->getNextAudioBlock(juce::AudioSourceChannelInfo(&scratch, 0, length));
+
+    const int size = buffer.getNumSamples();
+    const int ringStart = (int)(sectionStart % size);
+    const int firstPart = juce::jmin(length, size - ringStart);
+
+    for (int chan = 0; chan < numberOfChannels; ++chan)
+    {
+        buffer.copyFrom(chan, ringStart, scratch, chan, 0, firstPart);
+        if (firstPart < length)
+            buffer.copyFrom(chan, 0, scratch, chan, firstPart, length - firstPart);
+    }
+
+    validEnd.store(newBVE, std::memory_order_release);
+    return true;
+}
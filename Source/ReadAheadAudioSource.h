@@ -0,0 +1,94 @@
+/*
+  ==============================================================================
+
+    ReadAheadAudioSource.h
+    Created: 17 Oct 2026 10:02:41am
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// One background thread shared by every deck that streams with read-ahead.
+struct SharedReadAheadThread : public juce::TimeSliceThread
+{
+    SharedReadAheadThread() : juce::TimeSliceThread("Deck read-ahead")
+    {
+        startThread(juce::Thread::Priority::high);
+    }
+
+    ~SharedReadAheadThread() override
+    {
+        stopThread(2000);
+    }
+};
+
+// Ring-buffered wrapper around a PositionableAudioSource. Disk reads happen on
+// the TimeSliceThread only; the audio callback copies what is already buffered
+// and outputs silence (counted as an underrun) when the ring runs dry. The two
+// never share a lock: the reader publishes the buffered range through atomics,
+// and the callback checks after copying that none of it was overwritten meanwhile.
+class ReadAheadAudioSource : public juce::PositionableAudioSource,
+    private juce::TimeSliceClient
+{
+public:
+    ReadAheadAudioSource(juce::PositionableAudioSource* source,
+        juce::TimeSliceThread& thread,
+        bool deleteSourceWhenDeleted,
+        int bufferSizeSamples,
+        int numChannels);
+    ~ReadAheadAudioSource() override;
+
+    void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
+    void releaseResources() override;
+    void getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill) override;
+
+    void setNextReadPosition(juce::int64 newPosition) override;
+    juce::int64 getNextReadPosition() const override;
+    juce::int64 getTotalLength() const override { return source->getTotalLength(); }
+    bool isLooping() const override { return source->isLooping(); }
+
+    // Keeps a copy of the audio starting at this sample (a loop start), so a jump
+    // there plays from memory while the ring refills behind it; -1 clears it
+    void setPinnedRegion(juce::int64 startSample) { requestedPinStart = startSample; }
+
+    int getBufferSize() const { return numberOfSamplesToBuffer; }
+    float getFillLevel() const;
+    int getUnderrunCount() const { return underruns.load(); }
+    void resetUnderrunCount() { underruns = 0; }
+
+private:
+    int useTimeSlice() override;
+    bool readNextBufferChunk();
+    bool refreshPinnedRegion();
+
+    juce::OptionalScopedPointer<juce::PositionableAudioSource> source;
+    juce::TimeSliceThread& backgroundThread;
+    const int numberOfSamplesToBuffer;
+    const int numberOfChannels;
+
+    juce::AudioBuffer<float> buffer;   // ring, indexed by position % size
+    juce::AudioBuffer<float> scratch;  // disk reads land here before the copy in
+
+    // Written by the reader thread only. validStart moves up before the slots below it are
+    // reused, and validEnd after new audio is in; ringEpoch changes before the ring is refilled
+    // from a new position or the pinned copy is replaced, since either can overwrite audio
+    // the callback is still copying.
+    std::atomic<juce::int64> validStart{ 0 }, validEnd{ 0 };
+    std::atomic<juce::uint32> ringEpoch{ 0 };
+
+    juce::AudioBuffer<float> pinned;   // audio from pinnedStart
+    std::atomic<juce::int64> pinnedStart{ 0 };
+    std::atomic<int> pinnedLength{ 0 };
+    juce::int64 loadedPinStart = -1;   // reader thread only
+    std::atomic<juce::int64> requestedPinStart{ -1 };
+
+    // the start of the block being played: it only advances once the callback has copied the block
+    std::atomic<juce::int64> nextPlayPos{ 0 };
+    std::atomic<int> underruns{ 0 };
+    bool wasSourceLooping = false;     // reader thread only
+    std::atomic<bool> isPrepared{ false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ReadAheadAudioSource)
+};
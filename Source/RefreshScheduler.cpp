@@ -0,0 +1,68 @@
+/*
+  ==============================================================================
+
+    RefreshScheduler.cpp
+    Created: 18 Oct 2026 5:47:09am
+
+  ==============================================================================
+*/
+
+#include "RefreshScheduler.h"
+
+namespace
+{
+    // message thread only
+    RefreshScheduler::Stats stats;
+}
+
+RefreshScheduler::RefreshScheduler(juce::Component& c, std::function<bool()> r)
+    : component(c), refresh(std::move(r))
+{
+}
+
+RefreshScheduler::~RefreshScheduler()
+{
+    cancelPendingUpdate();
+    if (attachment != nullptr)
+        --stats.activeSchedulers;
+}
+
+RefreshScheduler::Stats RefreshScheduler::getStats()
+{
+    return stats;
+}
+
+void RefreshScheduler::requestRefresh()
+{
+    idleFrames = 0;
+
+    if (attachment != nullptr)
+        return;
+
+    attachment = std::make_unique<juce::VBlankAttachment>(&component, [this] { onVBlank(); });
+    ++stats.activeSchedulers;
+}
+
+void RefreshScheduler::onVBlank()
+{
+    auto start = juce::Time::getHighResolutionTicks();
+    const bool changing = refresh();
+    ++stats.wakeUps;
+    stats.busyTicks += juce::Time::getHighResolutionTicks() - start;
+
+    idleFrames = changing ? 0 : idleFrames + 1;
+
+    // the attachment cannot be destroyed from inside its own callback
+    if (idleFrames >= settleFrames)
+        triggerAsyncUpdate();
+}
+
+void RefreshScheduler::handleAsyncUpdate()
+{
+    // a request since the callback keeps it running
+    if (idleFrames < settleFrames || attachment == nullptr)
+        return;
+
+    attachment.reset();
+    --stats.activeSchedulers;
+}
@@ -0,0 +1,50 @@
+/*
+  ==============================================================================
+
+    RefreshScheduler.h
+    Created: 18 Oct 2026 5:47:09am
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// Runs a component's display refresh in step with the screen, and only while
+// there is something to show. requestRefresh() attaches to the display's vblank;
+// the refresh callback returns whether anything is still changing, and once it
+// has said no for a short settling period the scheduler detaches again, so an
+// idle deck causes no wake-ups at all.
+class RefreshScheduler : private juce::AsyncUpdater
+{
+public:
+    // Wake-ups and time spent in refresh callbacks, over every scheduler in the process
+    struct Stats
+    {
+        juce::int64 wakeUps = 0;
+        juce::int64 busyTicks = 0;
+        int activeSchedulers = 0;
+    };
+
+    RefreshScheduler(juce::Component& component, std::function<bool()> refresh);
+    ~RefreshScheduler() override;
+
+    // Message thread; after any change the refresh has to pick up
+    void requestRefresh();
+    bool isActive() const { return attachment != nullptr; }
+
+    static Stats getStats();
+
+private:
+    static constexpr int settleFrames = 30;  // half a second at 60 Hz, enough for a command to reach the audio thread
+
+    void onVBlank();
+    void handleAsyncUpdate() override;
+
+    juce::Component& component;
+    std::function<bool()> refresh;
+    std::unique_ptr<juce::VBlankAttachment> attachment;
+    int idleFrames = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RefreshScheduler)
+};
@@ -0,0 +1,257 @@
+/*
+  ==============================================================================
+
+    Resampler.cpp
+    Created: 17 Oct 2026 10:26:47pm
+
+  ==============================================================================
+*/
+
+#include "Resampler.h"
+#include "SimdOps.h"
+
+namespace
+{
+    constexpr int sincTaps = 32;
+    constexpr int sincPhases = 128;
+    constexpr double sincCutoff = 0.91;  // of Nyquist, leaving room for the window's transition band
+
+    // Decimating by r needs the cutoff lowered by r. Each band rounds the ratio up, so its
+    // table never lets through more than the output can hold; 8 is VarispeedSource's limit.
+    constexpr double bandRatios[] = { 1.0, 1.1, 1.25, 1.5, 2.0, 3.0, 4.0, 6.0, 8.0 };
+    constexpr int numBands = (int)(sizeof(bandRatios) / sizeof(bandRatios[0]));
+
+    int getBand(double ratio)
+    {
+        int band = 0;
+        while (band < numBands - 1 && bandRatios[band] < ratio)
+            ++band;
+        return band;
+    }
+
+    // One row of sincTaps coefficients per phase, plus a guard row so phase + 1 is always valid.
+    // Tap j weighs input[index - (sincTaps / 2 - 1) + j].
+    struct SincTable
+    {
+        explicit SincTable(double cutoff)
+        {
+            coefficients.resize((size_t)((sincPhases + 1) * sincTaps));
+
+            for (int phase = 0; phase <= sincPhases; ++phase)
+            {
+                const double fraction = (double)phase / sincPhases;
+                auto* row = coefficients.data() + phase * sincTaps;
+                double sum = 0.0;
+
+                for (int j = 0; j < sincTaps; ++j)
+                {
+                    const double t = (double)(j - (sincTaps / 2 - 1)) - fraction;
+                    const double x = juce::MathConstants<double>::pi * cutoff * t;
+                    const double sinc = std::abs(x) < 1.0e-9 ? 1.0 : std::sin(x) / x;
+
+                    // 4-term Blackman-Harris over the kernel span
+                    const double w = juce::MathConstants<double>::twoPi * (t + sincTaps / 2) / sincTaps;
+                    const double window = 0.35875 - 0.48829 * std::cos(w) + 0.14128 * std::cos(2.0 * w) - 0.01168 * std::cos(3.0 * w);
+
+                    row[j] = (float)(sinc * window);
+                    sum += row[j];
+                }
+
+                // unity gain at DC for every phase
+                for (int j = 0; j < sincTaps; ++j)
+                    row[j] = (float)(row[j] / sum);
+            }
+        }
+
+        const float* getRow(int phase) const { return coefficients.data() + phase * sincTaps; }
+
+        std::vector<float> coefficients;
+    };
+
+    const SincTable& getSincTable(double ratio)
+    {
+        struct Tables
+        {
+            Tables()
+            {
+                for (auto bandRatio : bandRatios)
+                    tables.emplace_back(sincCutoff / bandRatio);
+            }
+
+            std::vector<SincTable> tables;
+        };
+
+        static const Tables bands;
+        return bands.tables[(size_t)getBand(ratio)];
+    }
+
+    //==============================================================================
+    inline float linearAt(const float* x, float t)
+    {
+        return x[0] + t * (x[1] - x[0]);
+    }
+
+    inline float cubicAt(const float* x, float t)
+    {
+        const float c1 = 0.5f * (x[1] - x[-1]);
+        const float c2 = x[-1] - 2.5f * x[0] + 2.0f * x[1] - 0.5f * x[2];
+        const float c3 = 0.5f * (x[2] - x[-1]) + 1.5f * (x[0] - x[1]);
+        return ((c3 * t + c2) * t + c1) * t + x[0];
+    }
+
+    inline float sincAt(const SincTable& table, const float* x, float t)
+    {
+        const float phase = t * sincPhases;
+        const int row = (int)phase;
+        const float blend = phase - (float)row;
+        const auto* c0 = table.getRow(row);
+        const auto* c1 = table.getRow(row + 1);
+        const auto* taps = x - (sincTaps / 2 - 1);
+
+        float sum0 = 0.0f, sum1 = 0.0f;
+        for (int j = 0; j < sincTaps; ++j)
+        {
+            sum0 += taps[j] * c0[j];
+            sum1 += taps[j] * c1[j];
+        }
+
+        return sum0 + blend * (sum1 - sum0);
+    }
+
+    //==============================================================================
+   #if MELODYMIX_SIMD_AVAILABLE
+    using namespace simd;
+
+    // linear and cubic work on four output samples at a time
+    int processLinearSimd(const float* in, const int* indices, const float* fractions, float* out, int numSamples)
+    {
+        int i = 0;
+        for (; i + 4 <= numSamples; i += 4)
+        {
+            const Vec x0 = gather(in, indices + i, 0);
+            const Vec x1 = gather(in, indices + i, 1);
+            store(out + i, add(x0, mul(load(fractions + i), sub(x1, x0))));
+        }
+        return i;
+    }
+
+    int processCubicSimd(const float* in, const int* indices, const float* fractions, float* out, int numSamples)
+    {
+        const Vec half = splat(0.5f), oneAndHalf = splat(1.5f), two = splat(2.0f), twoAndHalf = splat(2.5f);
+
+        int i = 0;
+        for (; i + 4 <= numSamples; i += 4)
+        {
+            const Vec xm1 = gather(in, indices + i, -1);
+            const Vec x0 = gather(in, indices + i, 0);
+            const Vec x1 = gather(in, indices + i, 1);
+            const Vec x2 = gather(in, indices + i, 2);
+            const Vec t = load(fractions + i);
+
+            const Vec c1 = mul(half, sub(x1, xm1));
+            const Vec c2 = sub(add(xm1, mul(two, x1)), add(mul(twoAndHalf, x0), mul(half, x2)));
+            const Vec c3 = add(mul(half, sub(x2, xm1)), mul(oneAndHalf, sub(x0, x1)));
+
+            store(out + i, add(mul(add(mul(add(mul(c3, t), c2), t), c1), t), x0));
+        }
+        return i;
+    }
+
+    // the sinc kernel vectorises across its taps instead, one output sample at a time
+    int processSincSimd(const SincTable& table, const float* in, const int* indices, const float* fractions, float* out, int numSamples)
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float phase = fractions[i] * sincPhases;
+            const int row = (int)phase;
+            const float blend = phase - (float)row;
+            const auto* c0 = table.getRow(row);
+            const auto* c1 = table.getRow(row + 1);
+            const auto* taps = in + indices[i] - (sincTaps / 2 - 1);
+
+            Vec sum0 = splat(0.0f), sum1 = splat(0.0f);
+            for (int j = 0; j < sincTaps; j += 4)
+            {
+                const Vec x = load(taps + j);
+                sum0 = add(sum0, mul(x, load(c0 + j)));
+                sum1 = add(sum1, mul(x, load(c1 + j)));
+            }
+
+            const float s0 = horizontalSum(sum0);
+            out[i] = s0 + blend * (horizontalSum(sum1) - s0);
+        }
+        return numSamples;
+    }
+   #endif
+}
+
+namespace Resampler
+{
+    void processScalar(ResamplerQuality quality, double ratio, const float* input, const int* indices,
+        const float* fractions, float* output, int numSamples)
+    {
+        switch (quality)
+        {
+        case ResamplerQuality::linear:
+            for (int i = 0; i < numSamples; ++i)
+                output[i] = linearAt(input + indices[i], fractions[i]);
+            break;
+
+        case ResamplerQuality::cubic:
+            for (int i = 0; i < numSamples; ++i)
+                output[i] = cubicAt(input + indices[i], fractions[i]);
+            break;
+
+        case ResamplerQuality::sinc:
+        default:
+        {
+            const auto& table = getSincTable(ratio);
+            for (int i = 0; i < numSamples; ++i)
+                output[i] = sincAt(table, input + indices[i], fractions[i]);
+            break;
+        }
+        }
+    }
+
+    void process(ResamplerQuality quality, double ratio, const float* input, const int* indices,
+        const float* fractions, float* output, int numSamples)
+    {
+       #if MELODYMIX_SIMD_AVAILABLE
+        int done = 0;
+        switch (quality)
+        {
+        case ResamplerQuality::linear: done = processLinearSimd(input, indices, fractions, output, numSamples); break;
+        case ResamplerQuality::cubic:  done = processCubicSimd(input, indices, fractions, output, numSamples); break;
+        case ResamplerQuality::sinc:
+        default:                       done = processSincSimd(getSincTable(ratio), input, indices, fractions, output, numSamples); break;
+        }
+
+        // the last few samples that do not fill a whole vector
+        if (done < numSamples)
+            processScalar(quality, ratio, input, indices + done, fractions + done, output + done, numSamples - done);
+       #else
+        processScalar(quality, ratio, input, indices, fractions, output, numSamples);
+       #endif
+    }
+
+    double getCutoff(double ratio)
+    {
+        return sincCutoff / bandRatios[getBand(ratio)];
+    }
+
+    void initialiseTables()
+    {
+        getSincTable(1.0);
+    }
+
+    const char* getName(ResamplerQuality quality)
+    {
+        switch (quality)
+        {
+        case ResamplerQuality::linear: return "linear";
+        case ResamplerQuality::cubic:  return "cubic";
+        case ResamplerQuality::sinc:
+        default:                       return "sinc";
+        }
+    }
+}
@@ -0,0 +1,46 @@
+/*
+  ==============================================================================
+
+    Resampler.h
+    Created: 17 Oct 2026 10:26:47pm
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+enum class ResamplerQuality
+{
+    linear,   // 2 taps
+    cubic,    // 4-point Hermite
+    sinc      // 32-tap polyphase windowed sinc
+};
+
+// Interpolation kernels for the varispeed stage. Each output sample is the input
+// read at a fractional position, given as indices[i] + fractions[i]. The caller
+// keeps maxHistory samples before and maxLookahead samples after every index
+// readable. process() uses SSE or NEON where available; processScalar() is the
+// plain reference, also used for the benchmark comparison.
+// ratio is the input step per output sample. Above 1 the input is being decimated,
+// and the sinc kernel's cutoff drops with it so nothing folds back below Nyquist.
+namespace Resampler
+{
+    constexpr int maxHistory = 15;
+    constexpr int maxLookahead = 17;
+
+    void process(ResamplerQuality quality, double ratio, const float* input, const int* indices,
+        const float* fractions, float* output, int numSamples);
+
+    void processScalar(ResamplerQuality quality, double ratio, const float* input, const int* indices,
+        const float* fractions, float* output, int numSamples);
+
+    // The passband edge used at this ratio, as a fraction of the input's Nyquist. Ratios are
+    // rounded up to one of a few bands, each with its own sinc table.
+    double getCutoff(double ratio);
+
+    // Builds the sinc tables up front, so the audio thread never has to
+    void initialiseTables();
+
+    const char* getName(ResamplerQuality quality);
+}
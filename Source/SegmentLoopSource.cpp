@@ -0,0 +1,128 @@
+/*
+  ==============================================================================
+
+    SegmentLoopSource.cpp
+    Created: 17 Oct 2026 6:20:15pm
+
+  ==============================================================================
+*/
+
+#include "SegmentLoopSource.h"
+
+namespace
+{
+    // shorter segments would wrap so often that the loop degenerates into a buzz
+    constexpr juce::int64 minLoopLength = 32;
+}
+
+SegmentLoopSource::SegmentLoopSource(juce::PositionableAudioSource& in)
+    : input(in)
+{
+}
+
+void SegmentLoopSource::setLoopRange(juce::int64 startSample, juce::int64 endSample, bool enabled)
+{
+    loopStart = startSample;
+    loopEnd = endSample;
+    loopEnabled = enabled;
+}
+
+void SegmentLoopSource::setSeamCrossfadeLength(int numSamples)
+{
+    seamLength = juce::jlimit(0, maxSeamCrossfadeLength, numSamples);
+}
+
+void SegmentLoopSource::prepareToPlay(int samplesPerBlockExpected, double sampleRate)
+{
+    seamTail.setSize(2, maxSeamCrossfadeLength);
+    seamTailLength = 0;
+    seamPosition = 0;
+    input.prepareToPlay(samplesPerBlockExpected, sampleRate);
+}
+
+void SegmentLoopSource::releaseResources()
+{
+    input.releaseResources();
+}
+
+bool SegmentLoopSource::isLoopActive() const
+{
+    return loopEnabled && loopStart >= 0 && loopEnd - loopStart >= minLoopLength;
+}
+
+void SegmentLoopSource::getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill)
+{
+    if (!isLoopActive())
+    {
+        input.getNextAudioBlock(bufferToFill);
+        mixSeam(bufferToFill);
+        return;
+    }
+
+    int done = 0;
+    while (done < bufferToFill.numSamples)
+    {
+        auto position = input.getNextReadPosition();
+        if (position >= loopEnd)
+        {
+            wrapToLoopStart(position == loopEnd);
+            continue;
+        }
+
+        // render up to B at most, so the wrap lands on the exact sample
+        const int chunk = (int)juce::jmin((juce::int64)(bufferToFill.numSamples - done), loopEnd - position);
+        juce::AudioSourceChannelInfo part(bufferToFill.buffer, bufferToFill.startSample + done, chunk);
+
+        input.getNextAudioBlock(part);
+        mixSeam(part);
+        done += chunk;
+    }
+}
+
+void SegmentLoopSource::wrapToLoopStart(bool reachedLoopEnd)
+{
+    // a playhead that was moved past B just jumps; only a real pass through B gets a seam fade
+    seamTailLength = 0;
+    seamPosition = 0;
+
+    if (reachedLoopEnd && seamLength > 0 && seamTail.getNumSamples() >= seamLength)
+    {
+        input.getNextAudioBlock(juce::AudioSourceChannelInfo(&seamTail, 0, seamLength));
+        seamTailLength = seamLength;
+    }
+
+    input.setNextReadPosition(loopStart);
+}
+
+void SegmentLoopSource::mixSeam(const juce::AudioSourceChannelInfo& info)
+{
+    if (seamPosition >= seamTailLength)
+        return;
+
+    const int count = juce::jmin(info.numSamples, seamTailLength - seamPosition);
+    const int numChannels = juce::jmin(info.buffer->getNumChannels(), seamTail.getNumChannels());
+    const float step = 1.0f / (float)seamTailLength;
+
+    for (int chan = 0; chan < numChannels; ++chan)
+    {
+        auto* dest = info.buffer->getWritePointer(chan, info.startSample);
+        const auto* tail = seamTail.getReadPointer(chan, seamPosition);
+
+        // linear crossfade: the two sides are continuations of the same material
+        for (int i = 0; i < count; ++i)
+        {
+            const float gainIn = (float)(seamPosition + i) * step;
+            dest[i] = dest[i] * gainIn + tail[i] * (1.0f - gainIn);
+        }
+    }
+
+    seamPosition += count;
+}
+
+void SegmentLoopSource::setNextReadPosition(juce::int64 newPosition)
+{
+    // a seek abandons any seam still fading
+    seamTailLength = 0;
+    seamPosition = 0;
+    input.setNextReadPosition(newPosition);
+}
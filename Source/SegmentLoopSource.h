@@ -0,0 +1,54 @@
+/*
+  ==============================================================================
+
+    SegmentLoopSource.h
+    Created: 17 Oct 2026 6:20:15pm
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// Wraps a deck's source and loops an A/B segment: the jump back to A happens on
+// the exact sample where B is reached, whatever the block size. The seam can be
+// crossfaded with the audio that would have followed B to hide the discontinuity.
+// All setters are for the audio thread (or while the source is detached).
+class SegmentLoopSource : public juce::PositionableAudioSource
+{
+public:
+    explicit SegmentLoopSource(juce::PositionableAudioSource& input);
+
+    // Sample indices in the input's timeline; the loop is off unless endSample > startSample >= 0
+    void setLoopRange(juce::int64 startSample, juce::int64 endSample, bool enabled);
+    // 0 makes the jump a hard cut
+    void setSeamCrossfadeLength(int numSamples);
+
+    static constexpr int maxSeamCrossfadeLength = 8192;
+
+    void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
+    void releaseResources() override;
+    void getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill) override;
+
+    void setNextReadPosition(juce::int64 newPosition) override;
+    juce::int64 getNextReadPosition() const override { return input.getNextReadPosition(); }
+    juce::int64 getTotalLength() const override { return input.getTotalLength(); }
+    bool isLooping() const override { return input.isLooping(); }
+
+private:
+    bool isLoopActive() const;
+    void wrapToLoopStart(bool reachedLoopEnd);
+    void mixSeam(const juce::AudioSourceChannelInfo& info);
+
+    juce::PositionableAudioSource& input;
+    juce::int64 loopStart = -1;
+    juce::int64 loopEnd = -1;
+    bool loopEnabled = false;
+    int seamLength = 0;
+
+    juce::AudioBuffer<float> seamTail;  // what followed B, faded out over the start of the next pass
+    int seamTailLength = 0;
+    int seamPosition = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SegmentLoopSource)
+};
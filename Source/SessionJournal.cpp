@@ -0,0 +1,359 @@
+/*
+  ==============================================================================
+
+    SessionJournal.cpp
+    Created: 18 Oct 2026 8:31:06am
+
+  ==============================================================================
+*/
+
+#include "SessionJournal.h"
+#include "AtomicFile.h"
+
+namespace
+{
+    constexpr int journalMagic = 0x4e4a534d;   // "MSJN"
+    constexpr size_t headerSize = 8;          // magic, version
+    constexpr size_t framingSize = 9;         // type, payload size, checksum
+    constexpr size_t tracksPerRecord = 1024;  // when compacting
+    constexpr juce::int64 minGarbageToCompact = 64 * 1024;
+
+    // FNV-1a over the type and payload; catches a record the crash cut short or left half-written
+    juce::uint32 checksum(juce::uint8 type, const juce::uint8* payload, size_t size)
+    {
+        juce::uint32 hash = 2166136261u;
+        hash = (hash ^ type) * 16777619u;
+        for (size_t i = 0; i < size; ++i)
+            hash = (hash ^ payload[i]) * 16777619u;
+        return hash;
+    }
+
+    void writeHeader(juce::OutputStream& out)
+    {
+        out.writeInt(journalMagic);
+        out.writeInt(SessionJournal::formatVersion);
+    }
+}
+
+SessionJournal::SessionJournal(const juce::File& journalFile)
+    : juce::Thread("Session journal"), file(journalFile)
+{
+    startThread(juce::Thread::Priority::low);
+}
+
+SessionJournal::~SessionJournal()
+{
+    signalThreadShouldExit();
+    notify();
+    stopThread(10000);
+}
+
+bool SessionJournal::load(SessionState& loaded)
+{
+    juce::MemoryBlock data;
+    if (!file.loadFileAsData(data) || data.getSize() < headerSize)
+        return false;
+
+    juce::MemoryInputStream header(data, false);
+    if (header.readInt() != journalMagic)
+        return false;
+
+    // written by a newer build: leave it untouched rather than overwrite what it knows
+    if (header.readInt() > formatVersion)
+    {
+        disabled = true;
+        return false;
+    }
+
+    SessionState parsed;
+    JournalStats stats;
+    applyRecords(static_cast<const juce::uint8*>(data.getData()) + headerSize, data.getSize() - headerSize, parsed, stats);
+
+    // the writer is idle until the first record is queued, which the lock hands over with this
+    const juce::ScopedLock sl(queueLock);
+    state = parsed;
+    journalStats = stats;
+    validBytes = (juce::int64)headerSize + stats.wholeBytes;
+    loaded = std::move(parsed);
+    return true;
+}
+
+void SessionJournal::rewrite(const SessionState& newState)
+{
+    if (disabled)
+        return;
+
+    {
+        const juce::ScopedLock sl(queueLock);
+        pendingRewrite = std::make_unique<SessionState>(newState);
+        queued.reset();
+        ++queuedChanges;
+    }
+
+    notify();
+}
+
+void SessionJournal::setCurrent(const juce::String& path, double position)
+{
+    juce::MemoryOutputStream payload;
+    payload.writeString(path);
+    payload.writeDouble(position);
+    queueRecord(RecordType::current, payload.getMemoryBlock());
+}
+
+void SessionJournal::addMarker(const juce::String& name, double position)
+{
+    juce::MemoryOutputStream payload;
+    payload.writeString(name);
+    payload.writeDouble(position);
+    queueRecord(RecordType::addMarker, payload.getMemoryBlock());
+}
+
+void SessionJournal::clearMarkers()
+{
+    queueRecord(RecordType::clearMarkers, {});
+}
+
+void SessionJournal::addTracks(const std::vector<SessionState::Entry>& tracks)
+{
+    if (!tracks.empty())
+        queueRecord(RecordType::addTracks, makeEntriesPayload(tracks, 0, tracks.size()));
+}
+
+void SessionJournal::queueRecord(RecordType type, const juce::MemoryBlock& payload)
+{
+    if (disabled)
+        return;
+
+    {
+        const juce::ScopedLock sl(queueLock);
+        appendRecord(queued, type, payload);
+        ++queuedChanges;
+    }
+
+    notify();
+}
+
+bool SessionJournal::waitUntilWritten(int timeoutMilliseconds)
+{
+    juce::uint64 target;
+    {
+        const juce::ScopedLock sl(queueLock);
+        target = queuedChanges;
+    }
+
+    const auto deadline = juce::Time::getMillisecondCounter() + (juce::uint32)juce::jmax(0, timeoutMilliseconds);
+
+    while (writtenChanges.load() < target)
+    {
+        const auto now = juce::Time::getMillisecondCounter();
+        if (now >= deadline)
+            return false;
+
+        writtenEvent.wait((int)(deadline - now));
+    }
+
+    return true;
+}
+
+void SessionJournal::run()
+{
+    while (!threadShouldExit())
+    {
+        wait(-1);
+        writePending();
+    }
+
+    // whatever was queued before the owner went away
+    writePending();
+}
+
+void SessionJournal::writePending()
+{
+    juce::MemoryBlock bytes;
+    std::unique_ptr<SessionState> rewriteState;
+    juce::uint64 changes;
+
+    {
+        const juce::ScopedLock sl(queueLock);
+        bytes = queued.getMemoryBlock();
+        queued.reset();
+        rewriteState = std::move(pendingRewrite);
+        changes = queuedChanges;
+    }
+
+    if (rewriteState != nullptr)
+    {
+        state = std::move(*rewriteState);
+        compact();
+    }
+
+    if (bytes.getSize() > 0 && openForAppend())
+    {
+        stream->write(bytes.getData(), bytes.getSize());
+        stream->flush();
+
+        if (stream->getStatus().wasOk())
+        {
+            validBytes += (juce::int64)bytes.getSize();
+            applyRecords(static_cast<const juce::uint8*>(bytes.getData()), bytes.getSize(), state, journalStats);
+
+            if (journalStats.garbageBytes > juce::jmax(minGarbageToCompact, validBytes / 2))
+                compact();
+        }
+        else
+        {
+            // start over from the writer's state on the next write rather than append to a damaged file
+            stream.reset();
+            validBytes = 0;
+        }
+    }
+
+    writtenChanges = changes;
+    writtenEvent.signal();
+}
+
+bool SessionJournal::openForAppend()
+{
+    if (stream != nullptr)
+        return true;
+
+    // no journal yet, or one that could not be trusted: begin with the whole state
+    if (validBytes < (juce::int64)headerSize || !file.existsAsFile())
+    {
+        compact();
+        return stream != nullptr;
+    }
+
+    stream = std::make_unique<juce::FileOutputStream>(file);
+    if (!stream->openedOk())
+    {
+        stream.reset();
+        return false;
+    }
+
+    // drop a torn record left by a crash, so new ones follow the last whole record
+    stream->setPosition(validBytes);
+    stream->truncate();
+    return true;
+}
+
+void SessionJournal::compact()
+{
+    stream.reset();
+
+    juce::MemoryOutputStream data;
+    writeHeader(data);
+
+    juce::MemoryOutputStream current;
+    current.writeString(state.currentFile);
+    current.writeDouble(state.currentPosition);
+    appendRecord(data, RecordType::current, current.getMemoryBlock());
+
+    for (auto& marker : state.markers)
+    {
+        juce::MemoryOutputStream payload;
+        payload.writeString(marker.text);
+        payload.writeDouble(marker.position);
+        appendRecord(data, RecordType::addMarker, payload.getMemoryBlock());
+    }
+
+    for (size_t start = 0; start < state.tracks.size(); start += tracksPerRecord)
+        appendRecord(data, RecordType::addTracks,
+            makeEntriesPayload(state.tracks, start, juce::jmin(tracksPerRecord, state.tracks.size() - start)));
+
+    if (!writeFileAtomically(file, data.getMemoryBlock()))
+        return;
+
+    validBytes = (juce::int64)data.getDataSize();
+    journalStats = {};
+
+    stream = std::make_unique<juce::FileOutputStream>(file);
+    if (!stream->openedOk())
+        stream.reset();
+}
+
+void SessionJournal::appendRecord(juce::MemoryOutputStream& out, RecordType type, const juce::MemoryBlock& payload)
+{
+    const auto typeByte = (juce::uint8)type;
+    out.writeByte((char)typeByte);
+    out.writeInt((int)payload.getSize());
+    out.write(payload.getData(), payload.getSize());
+    out.writeInt((int)checksum(typeByte, static_cast<const juce::uint8*>(payload.getData()), payload.getSize()));
+}
+
+juce::MemoryBlock SessionJournal::makeEntriesPayload(const std::vector<SessionState::Entry>& entries, size_t start, size_t count)
+{
+    juce::MemoryOutputStream payload;
+    payload.writeCompressedInt((int)count);
+
+    for (size_t i = start; i < start + count; ++i)
+    {
+        payload.writeString(entries[i].text);
+        payload.writeDouble(entries[i].position);
+    }
+
+    return payload.getMemoryBlock();
+}
+
+void SessionJournal::applyRecords(const juce::uint8* data, size_t size, SessionState& target, JournalStats& stats)
+{
+    size_t offset = 0;
+
+    while (offset + framingSize <= size)
+    {
+        const auto typeByte = data[offset];
+        const auto payloadSize = (size_t)(juce::uint32)juce::ByteOrder::littleEndianInt(data + offset + 1);
+        if (payloadSize > size - offset - framingSize)
+            break;
+
+        const auto* payload = data + offset + 5;
+        const auto storedChecksum = (juce::uint32)juce::ByteOrder::littleEndianInt(payload + payloadSize);
+        if (storedChecksum != checksum(typeByte, payload, payloadSize))
+            break;
+
+        const auto recordSize = (juce::int64)(payloadSize + framingSize);
+        juce::MemoryInputStream in(payload, payloadSize, false);
+
+        switch ((RecordType)typeByte)
+        {
+        case RecordType::current:
+            // only the newest playhead counts
+            stats.garbageBytes += stats.currentBytes;
+            stats.currentBytes = recordSize;
+            target.currentFile = in.readString();
+            target.currentPosition = in.readDouble();
+            break;
+
+        case RecordType::addMarker:
+            stats.markerBytes += recordSize;
+            target.markers.push_back({ in.readString(), in.readDouble() });
+            break;
+
+        case RecordType::clearMarkers:
+            stats.garbageBytes += stats.markerBytes + recordSize;
+            stats.markerBytes = 0;
+            target.markers.clear();
+            break;
+
+        case RecordType::addTracks:
+        {
+            const int count = in.readCompressedInt();
+            for (int i = 0; i < count && !in.isExhausted(); ++i)
+            {
+                auto path = in.readString();
+                target.tracks.push_back({ path, in.readDouble() });
+            }
+            break;
+        }
+
+        default:
+            // a record type added after this version, in a journal that is still version-compatible
+            stats.garbageBytes += recordSize;
+            break;
+        }
+
+        offset += (size_t)recordSize;
+        stats.wholeBytes += recordSize;
+    }
+}
@@ -0,0 +1,109 @@
+/*
+  ==============================================================================
+
+    SessionJournal.h
+    Created: 18 Oct 2026 8:31:06am
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// Everything a deck restores at startup
+struct SessionState
+{
+    struct Entry
+    {
+        juce::String text;        // a marker's name, or a track's full path
+        double position = 0.0;
+    };
+
+    juce::String currentFile;
+    double currentPosition = 0.0;
+    std::vector<Entry> markers;
+    std::vector<Entry> tracks;
+};
+
+// A deck's session kept as a binary journal: each change is a small record appended
+// by a background writer, so nothing on the message thread waits for the disk.
+// Records are framed with their length and a checksum; a record torn by a crash is
+// dropped on the next load along with anything after it, and everything before it
+// survives. Once the journal has grown well past its live content it is compacted:
+// rewritten aside from the writer's own copy of the state and moved into place.
+// The file starts with a format version; a journal from a newer version is ignored.
+class SessionJournal : private juce::Thread
+{
+public:
+    static constexpr int formatVersion = 1;
+
+    explicit SessionJournal(const juce::File& journalFile);
+    // Writes whatever is still queued
+    ~SessionJournal() override;
+
+    // Message thread, before any change is recorded; one sequential read of the whole file.
+    // False if there is no usable journal.
+    bool load(SessionState& state);
+    // Replaces the journal with the given state, e.g. one carried over from an older format
+    void rewrite(const SessionState& state);
+
+    // Message thread; each queues one record and returns at once
+    void setCurrent(const juce::String& path, double position);
+    void addMarker(const juce::String& name, double position);
+    void clearMarkers();
+    void addTracks(const std::vector<SessionState::Entry>& tracks);
+    // Blocks until the writer has finished with everything queued before the call: written,
+    // or dropped by a failed write. False if that took longer than the timeout.
+    bool waitUntilWritten(int timeoutMilliseconds);
+
+    const juce::File& getFile() const { return file; }
+
+private:
+    enum class RecordType : juce::uint8
+    {
+        current = 1,
+        addMarker = 2,
+        clearMarkers = 3,
+        addTracks = 4
+    };
+
+    struct JournalStats
+    {
+        juce::int64 wholeBytes = 0;    // records that passed their checksum
+        juce::int64 garbageBytes = 0;  // records a later one has superseded
+        juce::int64 currentBytes = 0;  // the newest current record
+        juce::int64 markerBytes = 0;   // marker records since the last clear
+    };
+
+    void run() override;
+    void queueRecord(RecordType type, const juce::MemoryBlock& payload);
+    void writePending();
+    bool openForAppend();
+    void compact();
+
+    static void appendRecord(juce::MemoryOutputStream& out, RecordType type, const juce::MemoryBlock& payload);
+    static juce::MemoryBlock makeEntriesPayload(const std::vector<SessionState::Entry>& entries, size_t start, size_t count);
+    // Applies each record to state up to the first torn one, counting them in stats
+    static void applyRecords(const juce::uint8* data, size_t size, SessionState& state, JournalStats& stats);
+
+    const juce::File file;
+    bool disabled = false;  // set by load() for a journal from a newer version
+
+    // queued records, handed from the message thread to the writer
+    juce::CriticalSection queueLock;
+    juce::MemoryOutputStream queued;
+    std::unique_ptr<SessionState> pendingRewrite;
+    juce::uint64 queuedChanges = 0;  // records and rewrites queued so far
+
+    // how many of those the writer has finished with, signalled after each pass
+    std::atomic<juce::uint64> writtenChanges{ 0 };
+    juce::WaitableEvent writtenEvent;
+
+    // writer thread only, once it has started writing
+    SessionState state;
+    JournalStats journalStats;
+    std::unique_ptr<juce::FileOutputStream> stream;
+    juce::int64 validBytes = 0;  // length of the file up to its last whole record
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SessionJournal)
+};
@@ -0,0 +1,82 @@
+/*
+  ==============================================================================
+
+    SimdOps.h
+    Created: 17 Oct 2026 11:40:52pm
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// Four-lane float vectors over SSE2 or NEON, for the render-path kernels.
+// MELODYMIX_SIMD_AVAILABLE is 0 on other targets, where callers use their scalar loops.
+#if defined (JUCE_INTEL) && JUCE_INTEL
+ #include <emmintrin.h>
+ #define MELODYMIX_SIMD_USE_SSE 1
+ #define MELODYMIX_SIMD_USE_NEON 0
+#elif defined (JUCE_ARM) && JUCE_ARM && (defined (__ARM_NEON) || defined (__ARM_NEON__))
+ #include <arm_neon.h>
+ #define MELODYMIX_SIMD_USE_SSE 0
+ #define MELODYMIX_SIMD_USE_NEON 1
+#else
+ #define MELODYMIX_SIMD_USE_SSE 0
+ #define MELODYMIX_SIMD_USE_NEON 0
+#endif
+
+#define MELODYMIX_SIMD_AVAILABLE (MELODYMIX_SIMD_USE_SSE || MELODYMIX_SIMD_USE_NEON)
+
+#if MELODYMIX_SIMD_AVAILABLE
+namespace simd
+{
+    constexpr int width = 4;
+    constexpr int alignment = 16;  // bytes, for loadAligned / storeAligned
+
+   #if MELODYMIX_SIMD_USE_SSE
+    using Vec = __m128;
+    inline Vec load(const float* p)                   { return _mm_loadu_ps(p); }
+    inline void store(float* p, Vec v)                { _mm_storeu_ps(p, v); }
+    inline Vec loadAligned(const float* p)            { return _mm_load_ps(p); }
+    inline void storeAligned(float* p, Vec v)         { _mm_store_ps(p, v); }
+    inline Vec splat(float v)                         { return _mm_set1_ps(v); }
+    inline Vec set(float a, float b, float c, float d) { return _mm_setr_ps(a, b, c, d); }
+    inline Vec add(Vec a, Vec b)                      { return _mm_add_ps(a, b); }
+    inline Vec sub(Vec a, Vec b)                      { return _mm_sub_ps(a, b); }
+    inline Vec mul(Vec a, Vec b)                      { return _mm_mul_ps(a, b); }
+    inline float horizontalSum(Vec v)
+    {
+        Vec shuffled = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+        Vec sums = _mm_add_ps(v, shuffled);
+        shuffled = _mm_movehl_ps(shuffled, sums);
+        return _mm_cvtss_f32(_mm_add_ss(sums, shuffled));
+    }
+   #else
+    using Vec = float32x4_t;
+    inline Vec load(const float* p)                   { return vld1q_f32(p); }
+    inline void store(float* p, Vec v)                { vst1q_f32(p, v); }
+    inline Vec loadAligned(const float* p)            { return vld1q_f32(p); }
+    inline void storeAligned(float* p, Vec v)         { vst1q_f32(p, v); }
+    inline Vec splat(float v)                         { return vdupq_n_f32(v); }
+    inline Vec set(float a, float b, float c, float d)
+    {
+        const float values[4] = { a, b, c, d };
+        return vld1q_f32(values);
+    }
+    inline Vec add(Vec a, Vec b)                      { return vaddq_f32(a, b); }
+    inline Vec sub(Vec a, Vec b)                      { return vsubq_f32(a, b); }
+    inline Vec mul(Vec a, Vec b)                      { return vmulq_f32(a, b); }
+    inline float horizontalSum(Vec v)
+    {
+        const float32x2_t pairs = vadd_f32(vget_low_f32(v), vget_high_f32(v));
+        return vget_lane_f32(vpadd_f32(pairs, pairs), 0);
+    }
+   #endif
+
+    // in[idx[k] + offset] for the four lanes
+    inline Vec gather(const float* in, const int* idx, int offset)
+    {
+        return set(in[idx[0] + offset], in[idx[1] + offset], in[idx[2] + offset], in[idx[3] + offset]);
+    }
+}
+#endif
@@ -0,0 +1,185 @@
+/*
+  ==============================================================================
+
+    StatsPanel.cpp
+    Created: 18 Oct 2026 2:31:47am
+
+  ==============================================================================
+*/
+
+#include "StatsPanel.h"
+
+StatsPanel::StatsPanel(DeckMixer& m, juce::AudioDeviceManager& dm)
+    : mixer(m), deviceManager(dm)
+{
+    resetButton.onClick = [this]
+        {
+            mixer.getCallbackStats().reset();
+            if (auto* device = deviceManager.getCurrentAudioDevice())
+                xrunBaseline = juce::jmax(0, device->getXRunCount());
+        };
+    addAndMakeVisible(resetButton);
+    saveButton.onClick = [this] { saveReport(); };
+    addAndMakeVisible(saveButton);
+
+    refresh();
+    startTimer(500);
+    setSize(420, 400);
+}
+
+StatsPanel::~StatsPanel()
+{
+    stopTimer();
+}
+
+void StatsPanel::timerCallback()
+{
+    refresh();
+    repaint();
+}
+
+void StatsPanel::refresh()
+{
+    snapshot = mixer.getCallbackStats().getSnapshot();
+
+    auto* device = deviceManager.getCurrentAudioDevice();
+    const int xruns = device != nullptr ? device->getXRunCount() : -1;
+    deviceXRuns = xruns >= 0 ? juce::jmax(0, xruns - xrunBaseline) : -1;
+
+    const auto now = juce::Time::getHighResolutionTicks();
+    const auto wallTicks = lastRefreshTicks != 0 ? now - lastRefreshTicks : 0;
+    lastRefreshTicks = now;
+
+    const auto guiStats = RefreshScheduler::getStats();
+    guiActiveDecks = guiStats.activeSchedulers;
+    if (wallTicks > 0)
+    {
+        guiWakeUpsPerSecond = (double)(guiStats.wakeUps - lastGuiStats.wakeUps) / juce::Time::highResolutionTicksToSeconds(wallTicks);
+        guiBusyPercent = 100.0 * (double)(guiStats.busyTicks - lastGuiStats.busyTicks) / (double)wallTicks;
+    }
+    lastGuiStats = guiStats;
+
+    deckLoads.clear();
+
+    for (int slot = 0; slot < DeckMixer::maxDecks; ++slot)
+    {
+        auto* deck = mixer.getDeck(slot);
+        auto& last = lastTicks[(size_t)slot];
+
+        if (deck == nullptr)
+        {
+            lastDecks[(size_t)slot] = nullptr;
+            continue;
+        }
+
+        auto& stats = deck->getLoadStats();
+        const std::array<juce::int64, 3> ticks{ stats.decodeTicks.load(), stats.dspTicks.load(), stats.mixTicks.load() };
+
+        DeckLoad load;
+        const auto file = deck->getCurrentFile();
+        load.name = "Deck " + juce::String(slot + 1) + ": " + (file == juce::File() ? juce::String("(empty)") : file.getFileName());
+        load.underruns = deck->getReadAheadUnderruns();
+
+        // a deck that just moved into this slot has no previous totals to compare against
+        if (wallTicks > 0 && lastDecks[(size_t)slot] == deck)
+        {
+            const auto toPercent = [wallTicks](juce::int64 delta) { return 100.0 * (double)delta / (double)wallTicks; };
+            load.decodePercent = toPercent(ticks[0] - last[0]);
+            load.dspPercent = toPercent(ticks[1] - last[1]);
+            load.mixPercent = toPercent(ticks[2] - last[2]);
+        }
+
+        last = ticks;
+        lastDecks[(size_t)slot] = deck;
+        deckLoads.push_back(load);
+    }
+}
+
+juce::String StatsPanel::createReport() const
+{
+    juce::String report;
+    report << CallbackStats::createReport(snapshot)
+        << "device xruns: " << (deviceXRuns >= 0 ? juce::String(deviceXRuns) : juce::String("n/a")) << "\n"
+        << "display refresh: " << juce::String(guiWakeUpsPerSecond, 1) << " wake-ups/s, "
+        << juce::String(guiBusyPercent, 2) << "% of the message thread, " << guiActiveDecks << " decks active\n"
+        << "deck load (% of one core: decode / dsp / mix, read-ahead underruns):\n";
+
+    for (auto& load : deckLoads)
+        report << "  " << load.name << ": " << juce::String(load.decodePercent, 2) << " / "
+            << juce::String(load.dspPercent, 2) << " / " << juce::String(load.mixPercent, 2)
+            << ", " << load.underruns << "\n";
+
+    return report;
+}
+
+void StatsPanel::saveReport()
+{
+    auto file = juce::File::getSpecialLocation(juce::File::userDocumentsDirectory)
+        .getChildFile("audio_player_stats_" + juce::Time::getCurrentTime().formatted("%Y%m%d_%H%M%S") + ".txt");
+
+    if (file.replaceWithText(createReport()))
+        juce::AlertWindow::showMessageBoxAsync(juce::MessageBoxIconType::InfoIcon, "Stats", "Saved to " + file.getFullPathName());
+    else
+        juce::AlertWindow::showMessageBoxAsync(juce::MessageBoxIconType::WarningIcon, "Stats", "Could not write " + file.getFullPathName());
+}
+
+void StatsPanel::paint(juce::Graphics& g)
+{
+    g.fillAll(juce::Colours::darkgrey.darker());
+    g.setColour(juce::Colours::white);
+    g.setFont(13.0f);
+
+    auto area = getLocalBounds().reduced(8);
+    area.removeFromTop(30);
+
+    const juce::String summary = juce::String((int)snapshot.callbacks) + " callbacks, mean "
+        + juce::String(snapshot.meanMicros, 1) + " us, max " + juce::String(snapshot.maxMicros, 1)
+        + " us of " + juce::String(snapshot.deadlineMicros, 1) + " us";
+    g.drawText(summary, area.removeFromTop(18), juce::Justification::centredLeft);
+    g.drawText("Deadline misses: " + juce::String((int)snapshot.deadlineMisses)
+        + "   callback gaps: " + juce::String((int)snapshot.callbackGaps)
+        + "   device xruns: " + (deviceXRuns >= 0 ? juce::String(deviceXRuns) : juce::String("n/a")),
+        area.removeFromTop(18), juce::Justification::centredLeft);
+    g.drawText("Display refresh: " + juce::String(guiWakeUpsPerSecond, 1) + " wake-ups/s, "
+        + juce::String(guiBusyPercent, 2) + "% of the message thread, " + juce::String(guiActiveDecks) + " decks active",
+        area.removeFromTop(18), juce::Justification::centredLeft);
+
+    // histogram of callback durations; bins past 100% are over the deadline
+    auto histogramArea = area.removeFromTop(120).reduced(0, 6);
+    juce::uint32 tallest = 1;
+    for (auto count : snapshot.histogram)
+        tallest = juce::jmax(tallest, count);
+
+    const float barWidth = (float)histogramArea.getWidth() / (float)CallbackStats::numBins;
+    for (int i = 0; i < CallbackStats::numBins; ++i)
+    {
+        const float height = (float)histogramArea.getHeight() * (float)snapshot.histogram[(size_t)i] / (float)tallest;
+        g.setColour(i * CallbackStats::binPercent >= 100 ? juce::Colours::red : juce::Colours::lightgreen);
+        g.fillRect((float)histogramArea.getX() + i * barWidth, (float)histogramArea.getBottom() - height,
+            juce::jmax(1.0f, barWidth - 1.0f), height);
+    }
+
+    g.setColour(juce::Colours::grey);
+    const float deadlineX = (float)histogramArea.getX() + (100.0f / CallbackStats::binPercent) * barWidth;
+    g.drawVerticalLine((int)deadlineX, (float)histogramArea.getY(), (float)histogramArea.getBottom());
+
+    g.setColour(juce::Colours::white);
+    g.drawText("Deck load, % of one core (decode / DSP / mix, underruns)", area.removeFromTop(20), juce::Justification::centredLeft);
+
+    for (auto& load : deckLoads)
+    {
+        auto row = area.removeFromTop(16);
+        g.drawText(load.name, row.removeFromLeft(row.getWidth() / 2), juce::Justification::centredLeft, true);
+        g.drawText(juce::String(load.decodePercent, 1) + " / " + juce::String(load.dspPercent, 1) + " / "
+            + juce::String(load.mixPercent, 1) + ", " + juce::String(load.underruns),
+            row, juce::Justification::centredRight);
+    }
+}
+
+void StatsPanel::resized()
+{
+    auto buttonRow = getLocalBounds().reduced(8).removeFromTop(24);
+    resetButton.setBounds(buttonRow.removeFromLeft(80));
+    buttonRow.removeFromLeft(4);
+    saveButton.setBounds(buttonRow.removeFromLeft(100));
+}
@@ -0,0 +1,60 @@
+/*
+  ==============================================================================
+
+    StatsPanel.h
+    Created: 18 Oct 2026 2:31:47am
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "DeckMixer.h"
+#include "RefreshScheduler.h"
+
+// Live view of the audio engine's timing: the callback duration histogram,
+// deadline misses, dropouts reported by the device, and how much of each
+// deck's time goes to decoding, DSP and mixing, plus what the decks' display
+// refresh costs the message thread. The report can be saved as text.
+class StatsPanel : public juce::Component,
+    private juce::Timer
+{
+public:
+    StatsPanel(DeckMixer& mixer, juce::AudioDeviceManager& deviceManager);
+    ~StatsPanel() override;
+
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+
+private:
+    struct DeckLoad
+    {
+        juce::String name;
+        double decodePercent = 0.0, dspPercent = 0.0, mixPercent = 0.0;
+        int underruns = 0;
+    };
+
+    void timerCallback() override;
+    void refresh();
+    juce::String createReport() const;
+    void saveReport();
+
+    DeckMixer& mixer;
+    juce::AudioDeviceManager& deviceManager;
+    juce::TextButton resetButton{ "Reset" }, saveButton{ "Save report" };
+
+    CallbackStats::Snapshot snapshot;
+    int deviceXRuns = -1;  // -1 when the device does not report them
+    int xrunBaseline = 0;   // the device's count at the last reset
+    std::vector<DeckLoad> deckLoads;
+    double guiWakeUpsPerSecond = 0.0, guiBusyPercent = 0.0;
+    int guiActiveDecks = 0;
+    RefreshScheduler::Stats lastGuiStats;
+
+    // totals at the previous refresh, to turn running tick counts into a share of wall time
+    std::array<std::array<juce::int64, 3>, DeckMixer::maxDecks> lastTicks{};
+    std::array<PlayerAudio*, DeckMixer::maxDecks> lastDecks{};
+    juce::int64 lastRefreshTicks = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StatsPanel)
+};
@@ -0,0 +1,313 @@
+/*
+  ==============================================================================
+
+    TimeStretchSource.cpp
+    Created: 17 Oct 2026 7:41:52pm
+
+  ==============================================================================
+*/
+
+#include "TimeStretchSource.h"
+
+namespace
+{
+    constexpr int maxFrameSize = 2048;
+    constexpr int inputCapacity = 16384;
+    constexpr int pullChunkSize = 1024;
+    constexpr double minRatio = 0.25;
+    constexpr double maxRatio = 4.0;
+}
+
+TimeStretchSource::TimeStretchSource(juce::PositionableAudioSource& in)
+    : input(in)
+{
+}
+
+TimeStretchSource::Settings TimeStretchSource::getSettings(TimeStretchQuality quality)
+{
+    switch (quality)
+    {
+    case TimeStretchQuality::low:    return { 512, 64, 4 };
+    case TimeStretchQuality::high:   return { 2048, 320, 1 };
+    case TimeStretchQuality::medium:
+    default:                         return { 1024, 160, 2 };
+    }
+}
+
+void TimeStretchSource::setStretchRatio(double newRatio)
+{
+    ratio = newRatio > 0.0 ? juce::jlimit(minRatio, maxRatio, newRatio) : 0.0;
+}
+
+void TimeStretchSource::prepareToPlay(int samplesPerBlockExpected, double sampleRate)
+{
+    input.prepareToPlay(samplesPerBlockExpected, sampleRate);
+
+    inputBuffer.setSize(2, inputCapacity);
+    monoBuffer.setSize(1, inputCapacity);
+    overlapAdd.setSize(2, maxFrameSize);
+    switchFade.setSize(2, maxFrameSize);
+
+    // periodic Hann windows sum to exactly one at half-frame overlap
+    windows.setSize(3, maxFrameSize);
+    windows.clear();
+    for (auto q : { TimeStretchQuality::low, TimeStretchQuality::medium, TimeStretchQuality::high })
+    {
+        const int size = getSettings(q).frameSize;
+        auto* w = windows.getWritePointer((int)q);
+        for (int i = 0; i < size; ++i)
+            w[i] = 0.5f - 0.5f * std::cos(juce::MathConstants<float>::twoPi * (float)i / (float)size);
+    }
+
+    resetState();
+}
+
+void TimeStretchSource::releaseResources()
+{
+    input.releaseResources();
+}
+
+void TimeStretchSource::resetState()
+{
+    settings = getSettings(quality);
+    inputFill = 0;
+    nominalPosition = 0.0;
+    previousFrameStart = 0;
+    hasPreviousFrame = false;
+    readyPosition = 0;
+    readyCount = 0;
+    overlapAdd.clear();
+    switchFadeLength = 0;
+    switchFadePosition = 0;
+    flatFirstFrame = false;
+    playPosition = input.getNextReadPosition();
+}
+
+void TimeStretchSource::switchMode(bool nowActive)
+{
+    int fadeLength = 0;
+
+    if (wasActive && hasPreviousFrame)
+    {
+        // the stretcher pulls input ahead of what it plays; resume from the sample being heard
+        const auto resumePosition = playPosition.load() + readyPosition;
+
+        // still to play: the rest of this hop, then the last frame's tail
+        const int newHop = (nowActive ? getSettings(requestedQuality) : settings).frameSize / 2;
+        fadeLength = juce::jmin(settings.frameSize - readyPosition, newHop);
+
+        for (int chan = 0; chan < switchFade.getNumChannels(); ++chan)
+            switchFade.copyFrom(chan, 0, overlapAdd, chan, readyPosition, fadeLength);
+
+        input.setNextReadPosition(resumePosition);
+    }
+
+    wasActive = nowActive;
+    quality = requestedQuality;
+    resetState();
+
+    switchFadeLength = fadeLength;
+    flatFirstFrame = fadeLength > 0;
+}
+
+void TimeStretchSource::applySwitchFade(const juce::AudioSourceChannelInfo& bufferToFill)
+{
+    const int count = juce::jmin(bufferToFill.numSamples, switchFadeLength - switchFadePosition);
+    if (count <= 0)
+        return;
+
+    const int numChannels = juce::jmin(bufferToFill.buffer->getNumChannels(), switchFade.getNumChannels());
+    for (int chan = 0; chan < numChannels; ++chan)
+    {
+        auto* out = bufferToFill.buffer->getWritePointer(chan, bufferToFill.startSample);
+        const auto* old = switchFade.getReadPointer(chan, switchFadePosition);
+
+        for (int i = 0; i < count; ++i)
+        {
+            const float gain = (float)(switchFadePosition + i + 1) / (float)(switchFadeLength + 1);
+            out[i] = out[i] * gain + old[i] * (1.0f - gain);
+        }
+    }
+
+    switchFadePosition += count;
+}
+
+void TimeStretchSource::getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill)
+{
+    const double currentRatio = ratio.load();
+    const bool active = currentRatio > 0.0;
+    if (active != wasActive || quality != requestedQuality)
+        switchMode(active);
+
+    if (!active)
+    {
+        input.getNextAudioBlock(bufferToFill);
+        applySwitchFade(bufferToFill);
+        return;
+    }
+
+    const int numChannels = bufferToFill.buffer->getNumChannels();
+    int done = 0;
+
+    while (done < bufferToFill.numSamples)
+    {
+        if (readyCount == 0)
+            processHop();
+
+        const int count = juce::jmin(bufferToFill.numSamples - done, readyCount);
+        for (int chan = 0; chan < numChannels; ++chan)
+        {
+            if (chan < overlapAdd.getNumChannels())
+                bufferToFill.buffer->copyFrom(chan, bufferToFill.startSample + done, overlapAdd, chan, readyPosition, count);
+            else
+                bufferToFill.buffer->clear(chan, bufferToFill.startSample + done, count);
+        }
+
+        readyPosition += count;
+        readyCount -= count;
+        done += count;
+    }
+
+    applySwitchFade(bufferToFill);
+}
+
+void TimeStretchSource::processHop()
+{
+    const int frameSize = settings.frameSize;
+    const int hop = frameSize / 2;
+
+    // the first half of the buffer went out last time; the second half is the previous frame's tail
+    if (hasPreviousFrame)
+    {
+        for (int chan = 0; chan < overlapAdd.getNumChannels(); ++chan)
+        {
+            auto* ola = overlapAdd.getWritePointer(chan);
+            std::memmove(ola, ola + hop, sizeof(float) * (size_t)hop);
+            juce::FloatVectorOperations::clear(ola + hop, hop);
+        }
+    }
+
+    const int nominalStart = (int)nominalPosition;
+    int needed = nominalStart + settings.searchRadius + frameSize;
+    if (hasPreviousFrame)
+        needed = juce::jmax(needed, previousFrameStart + hop + frameSize);
+    ensureInput(needed);
+
+    const int frameStart = hasPreviousFrame ? findBestFrameStart(previousFrameStart + hop, nominalStart)
+                                            : nominalStart;
+
+    const auto* window = windows.getReadPointer((int)quality);
+    const int windowFrom = flatFirstFrame ? hop : 0;
+    flatFirstFrame = false;
+
+    for (int chan = 0; chan < overlapAdd.getNumChannels(); ++chan)
+    {
+        auto* ola = overlapAdd.getWritePointer(chan);
+        const auto* frame = inputBuffer.getReadPointer(chan, frameStart);
+
+        juce::FloatVectorOperations::add(ola, frame, windowFrom);
+        juce::FloatVectorOperations::addWithMultiply(ola + windowFrom, frame + windowFrom, window + windowFrom, frameSize - windowFrom);
+    }
+
+    previousFrameStart = frameStart;
+    hasPreviousFrame = true;
+    nominalPosition += hop * ratio.load();
+    readyPosition = 0;
+    readyCount = hop;
+
+    playPosition = input.getNextReadPosition() - (inputFill - frameStart);
+    discardConsumedInput();
+}
+
+int TimeStretchSource::findBestFrameStart(int targetStart, int nominalStart) const
+{
+    // the target is how the previous frame would naturally continue; pick the candidate
+    // whose start resembles it most, normalised so loud passages do not always win
+    const int overlap = settings.frameSize / 2;
+    const int stride = settings.searchStride;
+    const auto* mono = monoBuffer.getReadPointer(0);
+    const auto* target = mono + targetStart;
+
+    int best = nominalStart;
+    float bestScore = -std::numeric_limits<float>::max();
+
+    for (int candidate = juce::jmax(0, nominalStart - settings.searchRadius);
+        candidate <= nominalStart + settings.searchRadius; ++candidate)
+    {
+        const auto* c = mono + candidate;
+        float correlation = 0.0f, energy = 0.0f;
+
+        for (int i = 0; i < overlap; i += stride)
+        {
+            correlation += target[i] * c[i];
+            energy += c[i] * c[i];
+        }
+
+        const float score = correlation / std::sqrt(energy + 1.0e-9f);
+        if (score > bestScore)
+        {
+            bestScore = score;
+            best = candidate;
+        }
+    }
+
+    return best;
+}
+
+void TimeStretchSource::ensureInput(int numSamplesNeeded)
+{
+    jassert(numSamplesNeeded <= inputCapacity);
+
+    while (inputFill < numSamplesNeeded)
+    {
+        const int count = juce::jmin(pullChunkSize, inputCapacity - inputFill);
+        if (count <= 0)
+            break;
+
+        input.getNextAudioBlock(juce::AudioSourceChannelInfo(&inputBuffer, inputFill, count));
+
+        auto* mono = monoBuffer.getWritePointer(0, inputFill);
+        juce::FloatVectorOperations::copy(mono, inputBuffer.getReadPointer(0, inputFill), count);
+        juce::FloatVectorOperations::add(mono, inputBuffer.getReadPointer(1, inputFill), count);
+        juce::FloatVectorOperations::multiply(mono, 0.5f, count);
+
+        inputFill += count;
+    }
+}
+
+void TimeStretchSource::discardConsumedInput()
+{
+    // keep the next frame's natural continuation and its whole search range
+    const int keepFrom = juce::jmin(previousFrameStart + settings.frameSize / 2,
+        (int)nominalPosition - settings.searchRadius);
+    if (keepFrom <= 0)
+        return;
+
+    const int remaining = inputFill - keepFrom;
+    for (int chan = 0; chan < inputBuffer.getNumChannels(); ++chan)
+    {
+        auto* data = inputBuffer.getWritePointer(chan);
+        std::memmove(data, data + keepFrom, sizeof(float) * (size_t)remaining);
+    }
+
+    auto* mono = monoBuffer.getWritePointer(0);
+    std::memmove(mono, mono + keepFrom, sizeof(float) * (size_t)remaining);
+
+    inputFill = remaining;
+    previousFrameStart -= keepFrom;
+    nominalPosition -= keepFrom;
+}
+
+void TimeStretchSource::setNextReadPosition(juce::int64 newPosition)
+{
+    resetState();
+    playPosition = newPosition;
+    input.setNextReadPosition(newPosition);
+}
+
+juce::int64 TimeStretchSource::getNextReadPosition() const
+{
+    if (ratio.load() <= 0.0)
+        return input.getNextReadPosition();
+    return juce::jmax((juce::int64)0, playPosition.load());
+}
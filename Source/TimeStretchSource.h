@@ -0,0 +1,90 @@
+/*
+  ==============================================================================
+
+    TimeStretchSource.h
+    Created: 17 Oct 2026 7:41:52pm
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+enum class TimeStretchQuality
+{
+    low,
+    medium,
+    high
+};
+
+// WSOLA time-stretcher: changes tempo without changing pitch. Windowed frames are
+// taken from the input every (hop * ratio) samples, each one shifted by up to a
+// search radius to where it best lines up with the previous frame, and overlap-added
+// at a fixed hop. The work per output sample is fixed by the quality setting, so the
+// cost per block does not depend on the ratio or the material.
+// The setters are for the audio thread (or while the source is detached).
+class TimeStretchSource : public juce::PositionableAudioSource
+{
+public:
+    explicit TimeStretchSource(juce::PositionableAudioSource& input);
+
+    // Tempo ratio (2.0 plays twice as fast); 0 bypasses the stretcher entirely
+    void setStretchRatio(double newRatio);
+    void setQuality(TimeStretchQuality newQuality) { requestedQuality = newQuality; }
+
+    void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
+    void releaseResources() override;
+    void getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill) override;
+
+    // The input position of the frame currently being played
+    void setNextReadPosition(juce::int64 newPosition) override;
+    juce::int64 getNextReadPosition() const override;
+    juce::int64 getTotalLength() const override { return input.getTotalLength(); }
+    bool isLooping() const override { return input.isLooping(); }
+
+private:
+    struct Settings
+    {
+        int frameSize;     // hop is half of this
+        int searchRadius;
+        int searchStride;  // correlate every Nth sample
+    };
+
+    static Settings getSettings(TimeStretchQuality quality);
+
+    void resetState();
+    void switchMode(bool nowActive);
+    void applySwitchFade(const juce::AudioSourceChannelInfo& bufferToFill);
+    void processHop();
+    void ensureInput(int numSamplesNeeded);
+    void discardConsumedInput();
+    int findBestFrameStart(int targetStart, int nominalStart) const;
+
+    juce::PositionableAudioSource& input;
+    std::atomic<double> ratio{ 0.0 };
+    bool wasActive = false;
+    TimeStretchQuality requestedQuality = TimeStretchQuality::medium;
+    TimeStretchQuality quality = TimeStretchQuality::medium;
+    Settings settings = getSettings(TimeStretchQuality::medium);
+
+    juce::AudioBuffer<float> inputBuffer;  // unconsumed input, oldest first
+    juce::AudioBuffer<float> monoBuffer;   // mono mix of inputBuffer, for the similarity search
+    juce::AudioBuffer<float> overlapAdd;   // output under construction
+    juce::AudioBuffer<float> windows;      // one Hann window per quality
+    int inputFill = 0;
+    double nominalPosition = 0.0;          // where the next frame would start without the search
+    int previousFrameStart = 0;
+    bool hasPreviousFrame = false;
+    int readyPosition = 0;
+    int readyCount = 0;
+
+    // after a mode or quality switch, what the old setting had yet to play, faded out over the new start
+    juce::AudioBuffer<float> switchFade;
+    int switchFadeLength = 0;
+    int switchFadePosition = 0;
+    bool flatFirstFrame = false;           // the fade covers the seam, so the first frame starts at full level
+
+    std::atomic<juce::int64> playPosition{ 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TimeStretchSource)
+};
@@ -0,0 +1,199 @@
+/*
+  ==============================================================================
+
+    VarispeedSource.cpp
+    Created: 17 Oct 2026 9:05:33pm
+
+  ==============================================================================
+*/
+
+#include "VarispeedSource.h"
+
+namespace
+{
+    constexpr int inputCapacity = 8192;
+    constexpr int chunkSize = 256;
+    constexpr int pullChunkSize = 1024;
+    // sized for the widest interpolator, so the quality can change between blocks
+    constexpr int historySamples = Resampler::maxHistory;
+    constexpr int lookaheadSamples = Resampler::maxLookahead + 1;  // plus one for rounding
+    constexpr double minRatio = 0.05;
+    constexpr double maxRatio = 8.0;   // 4x speed from a 96 kHz file on a 48 kHz device
+    constexpr double glideSeconds = 0.03;
+}
+
+VarispeedSource::VarispeedSource(juce::PositionableAudioSource& in)
+    : input(in)
+{
+}
+
+double VarispeedSource::getTargetRatio() const
+{
+    return juce::jlimit(minRatio, maxRatio, speed.load() * (1.0 + nudge.load()) * rateConversion);
+}
+
+void VarispeedSource::prepareToPlay(int samplesPerBlockExpected, double sampleRate)
+{
+    input.prepareToPlay(samplesPerBlockExpected, sampleRate);
+
+    inputBuffer.setSize(2, inputCapacity);
+    Resampler::initialiseTables();
+
+    const double inputRate = sourceSampleRate.load();
+    rateConversion = inputRate > 0.0 && sampleRate > 0.0 ? inputRate / sampleRate : 1.0;
+    glideCoefficient = sampleRate > 0.0 ? 1.0 - std::exp(-1.0 / (glideSeconds * sampleRate)) : 1.0;
+
+    // a freshly attached source starts at the requested speed rather than gliding to it
+    currentRatio = getTargetRatio();
+    resetState();
+}
+
+void VarispeedSource::releaseResources()
+{
+    input.releaseResources();
+}
+
+void VarispeedSource::resetState()
+{
+    if (inputBuffer.getNumSamples() > 0)
+        inputBuffer.clear(0, historySamples);
+
+    inputFill = historySamples;
+    readPosition = historySamples;
+    playPosition = input.getNextReadPosition();
+
+    for (auto& filter : antiAliasFilters)
+        filter.reset();
+}
+
+void VarispeedSource::getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill)
+{
+    const double targetRatio = getTargetRatio();
+    int done = 0;
+
+    while (done < bufferToFill.numSamples)
+    {
+        const int count = juce::jmin(chunkSize, bufferToFill.numSamples - done);
+
+        // the ratio only moves towards the target, so the larger of the two bounds this chunk's input
+        const double maxStep = juce::jmax(currentRatio, targetRatio);
+        updateAntiAliasing(maxStep);
+        ensureInput((int)(readPosition + count * maxStep) + lookaheadSamples);
+
+        renderChunk(*bufferToFill.buffer, bufferToFill.startSample + done, count, targetRatio);
+        discardConsumedInput();
+        done += count;
+    }
+
+    playPosition = input.getNextReadPosition() - (juce::int64)(inputFill - readPosition);
+}
+
+void VarispeedSource::renderChunk(juce::AudioBuffer<float>& dest, int startSample, int numSamples, double targetRatio)
+{
+    const int numChannels = juce::jmin(dest.getNumChannels(), inputBuffer.getNumChannels());
+
+    for (int chan = numChannels; chan < dest.getNumChannels(); ++chan)
+        dest.clear(chan, startSample, numSamples);
+
+    // at unity speed on a whole-sample position this is a plain copy
+    if (currentRatio == 1.0 && targetRatio == 1.0 && readPosition == std::floor(readPosition))
+    {
+        for (int chan = 0; chan < numChannels; ++chan)
+            dest.copyFrom(chan, startSample, inputBuffer, chan, (int)readPosition, numSamples);
+
+        readPosition += numSamples;
+        return;
+    }
+
+    static_assert(chunkSize == std::tuple_size<decltype(chunkIndices)>::value, "one slot per chunk sample");
+
+    double position = readPosition, ratio = currentRatio;
+    const double kernelRatio = juce::jmax(currentRatio, targetRatio);
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const int index = (int)position;
+        chunkIndices[(size_t)i] = index;
+        chunkFractions[(size_t)i] = (float)(position - index);
+
+        ratio += (targetRatio - ratio) * glideCoefficient;
+        position += ratio;
+    }
+
+    const auto kernel = quality.load();
+    for (int chan = 0; chan < numChannels; ++chan)
+        Resampler::process(kernel, kernelRatio, inputBuffer.getReadPointer(chan), chunkIndices.data(), chunkFractions.data(),
+            dest.getWritePointer(chan, startSample), numSamples);
+
+    // snap once close enough, so unity speed gets its copy path back
+    currentRatio = std::abs(ratio - targetRatio) < 1.0e-6 ? targetRatio : ratio;
+    readPosition = position;
+}
+
+void VarispeedSource::updateAntiAliasing(double ratio)
+{
+    const double cutoff = quality.load() != ResamplerQuality::sinc && ratio > 1.0 ? Resampler::getCutoff(ratio) : 0.0;
+    if (cutoff == antiAliasCutoff)
+        return;
+
+    // switched back on: the old state belongs to input that has long been played
+    if (antiAliasCutoff == 0.0)
+        for (auto& filter : antiAliasFilters)
+            filter.reset();
+
+    antiAliasCutoff = cutoff;
+
+    // a sample rate of 2 puts Nyquist at 1
+    if (cutoff > 0.0)
+        for (auto& filter : antiAliasFilters)
+            filter.setCoefficients(juce::IIRCoefficients::makeLowPass(2.0, cutoff));
+}
+
+void VarispeedSource::ensureInput(int numSamplesNeeded)
+{
+    jassert(numSamplesNeeded <= inputCapacity);
+
+    while (inputFill < numSamplesNeeded)
+    {
+        const int count = juce::jmin(pullChunkSize, inputCapacity - inputFill);
+        if (count <= 0)
+            break;
+
+        input.getNextAudioBlock(juce::AudioSourceChannelInfo(&inputBuffer, inputFill, count));
+
+        if (antiAliasCutoff > 0.0)
+            for (int chan = 0; chan < inputBuffer.getNumChannels(); ++chan)
+                antiAliasFilters[(size_t)chan].processSamples(inputBuffer.getWritePointer(chan, inputFill), count);
+
+        inputFill += count;
+    }
+}
+
+void VarispeedSource::discardConsumedInput()
+{
+    const int keepFrom = (int)readPosition - historySamples;
+    if (keepFrom <= 0)
+        return;
+
+    const int remaining = inputFill - keepFrom;
+    for (int chan = 0; chan < inputBuffer.getNumChannels(); ++chan)
+    {
+        auto* data = inputBuffer.getWritePointer(chan);
+        std::memmove(data, data + keepFrom, sizeof(float) * (size_t)remaining);
+    }
+
+    inputFill = remaining;
+    readPosition -= keepFrom;
+}
+
+void VarispeedSource::setNextReadPosition(juce::int64 newPosition)
+{
+    resetState();
+    input.setNextReadPosition(newPosition);
+    playPosition = newPosition;
+}
+
+juce::int64 VarispeedSource::getNextReadPosition() const
+{
+    return juce::jmax((juce::int64)0, playPosition.load());
+}
@@ -0,0 +1,77 @@
+/*
+  ==============================================================================
+
+    VarispeedSource.h
+    Created: 17 Oct 2026 9:05:33pm
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "Resampler.h"
+
+// Resampling speed stage in a deck's render path: like a turntable, faster also
+// means higher. Speed and nudge can change at any time; the ratio glides to the
+// new value sample by sample, so there is no need to stop, re-attach or seek.
+// It also converts from the source's sample rate to the device rate, so the
+// transport above it runs without a resampler of its own.
+// The setters may be called from the audio thread or while the source is detached.
+class VarispeedSource : public juce::PositionableAudioSource
+{
+public:
+    explicit VarispeedSource(juce::PositionableAudioSource& input);
+
+    // 2.0 plays twice as fast and an octave up
+    void setSpeed(double newSpeed) { speed = newSpeed; }
+    // Temporary bend on top of the speed for beat-matching, e.g. 0.04 = 4% faster; 0 releases it
+    void setNudge(double amount) { nudge = amount; }
+    // Interpolator used for both speed changes and rate conversion; takes effect on the next block
+    void setQuality(ResamplerQuality newQuality) { quality = newQuality; }
+    // Rate of the input; set while detached, before prepareToPlay(). 0 means it matches the device.
+    void setSourceSampleRate(double newRate) { sourceSampleRate = newRate; }
+    double getSourceSampleRate() const { return sourceSampleRate; }
+
+    void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
+    void releaseResources() override;
+    void getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill) override;
+
+    // The input position of the sample currently being played
+    void setNextReadPosition(juce::int64 newPosition) override;
+    juce::int64 getNextReadPosition() const override;
+    juce::int64 getTotalLength() const override { return input.getTotalLength(); }
+    bool isLooping() const override { return input.isLooping(); }
+
+private:
+    double getTargetRatio() const;
+    void resetState();
+    void updateAntiAliasing(double ratio);
+    void ensureInput(int numSamplesNeeded);
+    void discardConsumedInput();
+    void renderChunk(juce::AudioBuffer<float>& dest, int startSample, int numSamples, double targetRatio);
+
+    juce::PositionableAudioSource& input;
+    std::atomic<double> speed{ 1.0 };
+    std::atomic<double> nudge{ 0.0 };
+    std::atomic<ResamplerQuality> quality{ ResamplerQuality::sinc };
+    std::atomic<double> sourceSampleRate{ 0.0 };
+    double rateConversion = 1.0;           // source rate / device rate
+
+    juce::AudioBuffer<float> inputBuffer;  // unconsumed input plus the interpolator's history
+    int inputFill = 0;
+    double readPosition = 0.0;             // fractional index into inputBuffer
+    double currentRatio = 1.0;
+    double glideCoefficient = 1.0;
+
+    // linear and cubic have no filter of their own: when decimating, the input is low-passed as it arrives
+    std::array<juce::IIRFilter, 2> antiAliasFilters;
+    double antiAliasCutoff = 0.0;          // of the input's Nyquist; 0 while off
+
+    // read positions of the current chunk, shared by all channels
+    std::array<int, 256> chunkIndices{};
+    std::array<float, 256> chunkFractions{};
+
+    std::atomic<juce::int64> playPosition{ 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(VarispeedSource)
+};
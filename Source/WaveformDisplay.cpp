@@ -0,0 +1,218 @@
+/*
+  ==============================================================================
+
+    WaveformDisplay.cpp
+    Created: 18 Oct 2026 5:20:18am
+
+  ==============================================================================
+*/
+
+#include "WaveformDisplay.h"
+
+namespace
+{
+    constexpr double maxZoom = 256.0;
+    const juce::Colour backgroundColour = juce::Colour::fromRGB(30, 30, 30);
+    const juce::Colour envelopeColour = juce::Colours::orange.withAlpha(0.55f);
+    const juce::Colour rmsColour = juce::Colours::orange;
+}
+
+WaveformDisplay::WaveformDisplay()
+{
+    setOpaque(true);
+}
+
+WaveformDisplay::~WaveformDisplay()
+{
+    stopTimer();
+}
+
+void WaveformDisplay::setFile(const juce::File& file)
+{
+    if (file == generator.getFile())
+        return;
+
+    generator.setFile(file);
+    peaks.reset();
+    drawnReady = -1;
+    imageValid = false;
+    zoom = 1.0;
+    repaint();
+
+    // poll while the worker opens and analyses the track; stops once it is complete
+    if (file != juce::File())
+        startTimer(100);
+    else
+        stopTimer();
+}
+
+void WaveformDisplay::timerCallback()
+{
+    auto latest = generator.getPeaks();
+    if (latest != peaks)
+    {
+        peaks = std::move(latest);
+        drawnReady = -1;
+        imageValid = false;
+    }
+
+    if (peaks == nullptr)
+        return;
+
+    if (peaks->getNumReady(0) != drawnReady)
+    {
+        imageValid = false;
+        repaint();
+    }
+
+    if (peaks->isComplete() && drawnReady == peaks->getNumReady(0))
+        stopTimer();
+}
+
+void WaveformDisplay::setPlayhead(double fraction)
+{
+    // the user is dragging; don't pull the playhead back under the mouse
+    if (isMouseButtonDown())
+        return;
+
+    playhead = juce::jlimit(0.0, 1.0, fraction);
+
+    // zoomed in, the view scrolls with the playhead, so count pixels across the whole zoomed track
+    const int x = (int)(playhead * getWidth() * zoom);
+    if (x == playheadX)
+        return;
+
+    playheadX = x;
+    repaint();
+}
+
+juce::Range<double> WaveformDisplay::getVisibleRange() const
+{
+    const double width = 1.0 / zoom;
+    const double start = juce::jlimit(0.0, 1.0 - width, playhead - width / 2);
+    return { start, start + width };
+}
+
+int WaveformDisplay::fractionToX(double fraction) const
+{
+    auto range = getVisibleRange();
+    return juce::roundToInt((fraction - range.getStart()) / range.getLength() * getWidth());
+}
+
+void WaveformDisplay::renderWaveform()
+{
+    const int width = getWidth(), height = getHeight();
+    if (width <= 0 || height <= 0)
+        return;
+
+    if (waveformImage.getWidth() != width || waveformImage.getHeight() != height)
+        waveformImage = juce::Image(juce::Image::RGB, width, height, false);
+
+    juce::Graphics g(waveformImage);
+    g.fillAll(backgroundColour);
+
+    imageRange = getVisibleRange();
+    imageValid = true;
+
+    if (peaks == nullptr || peaks->getLengthInSamples() == 0)
+        return;
+
+    drawnReady = peaks->getNumReady(0);
+
+    // the coarsest level that still has at least one peak per pixel
+    const double length = (double)peaks->getLengthInSamples();
+    const double samplesPerPixel = length * imageRange.getLength() / width;
+    int level = 0;
+    while (level + 1 < WaveformPeaks::numLevels && WaveformPeaks::getSamplesPerPeak(level + 1) <= samplesPerPixel)
+        ++level;
+
+    const auto* levelPeaks = peaks->getPeaks(level);
+    const int numReady = peaks->getNumReady(level);
+    const double samplesPerPeak = WaveformPeaks::getSamplesPerPeak(level);
+    const float centre = height * 0.5f, halfHeight = height * 0.5f;
+
+    for (int x = 0; x < width; ++x)
+    {
+        const double startSample = (imageRange.getStart() + imageRange.getLength() * x / width) * length;
+        const double endSample = (imageRange.getStart() + imageRange.getLength() * (x + 1) / width) * length;
+        const int first = (int)(startSample / samplesPerPeak);
+        const int last = juce::jmin(numReady, juce::jmax(first + 1, (int)std::ceil(endSample / samplesPerPeak)));
+
+        // not analysed yet: left as background
+        if (first >= last)
+            continue;
+
+        int min = 127, max = -127;
+        double sumSquares = 0.0;
+        for (int i = first; i < last; ++i)
+        {
+            min = juce::jmin(min, (int)levelPeaks[i].min);
+            max = juce::jmax(max, (int)levelPeaks[i].max);
+            sumSquares += (double)levelPeaks[i].rms * levelPeaks[i].rms;
+        }
+
+        const float rms = (float)(std::sqrt(sumSquares / (last - first)) / 255.0);
+
+        g.setColour(envelopeColour);
+        g.drawVerticalLine(x, centre - halfHeight * max / 127.0f, centre - halfHeight * min / 127.0f + 1.0f);
+        g.setColour(rmsColour);
+        g.drawVerticalLine(x, centre - halfHeight * rms, centre + halfHeight * rms + 1.0f);
+    }
+}
+
+void WaveformDisplay::paint(juce::Graphics& g)
+{
+    if (!imageValid || imageRange != getVisibleRange())
+        renderWaveform();
+
+    if (waveformImage.isValid())
+        g.drawImageAt(waveformImage, 0, 0);
+    else
+        g.fillAll(backgroundColour);
+
+    // what has already played is shaded, the playhead drawn on top
+    const int x = fractionToX(playhead);
+    g.setColour(juce::Colours::black.withAlpha(0.35f));
+    g.fillRect(0, 0, juce::jlimit(0, getWidth(), x), getHeight());
+    g.setColour(juce::Colours::white);
+    g.drawVerticalLine(x, 0.0f, (float)getHeight());
+}
+
+void WaveformDisplay::resized()
+{
+    imageValid = false;
+}
+
+void WaveformDisplay::mouseDown(const juce::MouseEvent& e)
+{
+    mouseDrag(e);
+}
+
+void WaveformDisplay::mouseDrag(const juce::MouseEvent& e)
+{
+    if (getWidth() <= 0)
+        return;
+
+    auto range = getVisibleRange();
+    const double fraction = juce::jlimit(0.0, 1.0, range.getStart() + range.getLength() * e.position.x / getWidth());
+
+    if (onSeek != nullptr)
+        onSeek(fraction);
+
+    // zoomed in, moving the playhead would scroll the view under the mouse
+    if (zoom == 1.0)
+    {
+        playhead = fraction;
+        repaint();
+    }
+}
+
+void WaveformDisplay::mouseWheelMove(const juce::MouseEvent&, const juce::MouseWheelDetails& wheel)
+{
+    if (wheel.deltaY == 0.0f)
+        return;
+
+    zoom = juce::jlimit(1.0, maxZoom, zoom * (wheel.deltaY > 0.0f ? 1.5 : 1.0 / 1.5));
+    playheadX = -1;
+    repaint();
+}
@@ -0,0 +1,57 @@
+/*
+  ==============================================================================
+
+    WaveformDisplay.h
+    Created: 18 Oct 2026 5:20:18am
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "WaveformPeaks.h"
+
+// A deck's track overview with its playhead: min/max envelope, RMS body, and the
+// part still being analysed left dim. Click or drag to seek; the mouse wheel
+// zooms in around the playhead, picking the pyramid level that matches the zoom.
+class WaveformDisplay : public juce::Component,
+    private juce::Timer
+{
+public:
+    WaveformDisplay();
+    ~WaveformDisplay() override;
+
+    // Starts analysing (or reading the cached peaks of) the deck's current track
+    void setFile(const juce::File& file);
+    const juce::File& getFile() const { return generator.getFile(); }
+
+    // Playhead as a fraction of the track; repaints only when it moves to another pixel
+    void setPlayhead(double fraction);
+    std::function<void(double fraction)> onSeek;
+
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+    void mouseDown(const juce::MouseEvent& e) override;
+    void mouseDrag(const juce::MouseEvent& e) override;
+    void mouseWheelMove(const juce::MouseEvent& e, const juce::MouseWheelDetails& wheel) override;
+
+private:
+    void timerCallback() override;
+    juce::Range<double> getVisibleRange() const;  // fractions of the track
+    int fractionToX(double fraction) const;
+    void renderWaveform();
+
+    WaveformGenerator generator;
+    std::shared_ptr<const WaveformPeaks> peaks;
+    int drawnReady = -1;  // level-0 peaks ready when the image was last drawn
+
+    juce::Image waveformImage;
+    juce::Range<double> imageRange;
+    bool imageValid = false;
+
+    double playhead = 0.0;
+    int playheadX = -1;
+    double zoom = 1.0;  // 1 shows the whole track
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(WaveformDisplay)
+};
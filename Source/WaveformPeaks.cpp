@@ -0,0 +1,322 @@
+/*
+  ==============================================================================
+
+    WaveformPeaks.cpp
+    Created: 18 Oct 2026 4:52:40am
+
+  ==============================================================================
+*/
+
+#include "WaveformPeaks.h"
+#include "AtomicFile.h"
+
+namespace
+{
+    constexpr int peaksMagic = 0x4b50574d;   // "MWPK"
+    constexpr int cacheMagic = 0x4843574d;   // "MWCH"
+    constexpr int formatVersion = 1;
+    constexpr int analysisBlockSize = 65536;
+
+    juce::int8 quantiseSigned(float value)
+    {
+        return (juce::int8)juce::jlimit(-127, 127, juce::roundToInt(value * 127.0f));
+    }
+
+    juce::uint8 quantiseUnsigned(double value)
+    {
+        return (juce::uint8)juce::jlimit(0, 255, juce::roundToInt(value * 255.0));
+    }
+}
+
+WaveformPeaks::WaveformPeaks(juce::int64 length, double rate)
+    : lengthInSamples(juce::jmax((juce::int64)0, length)), sampleRate(rate)
+{
+    for (int level = 0; level < numLevels; ++level)
+    {
+        const auto samplesPerPeak = (juce::int64)getSamplesPerPeak(level);
+        levels[(size_t)level].resize((size_t)((lengthInSamples + samplesPerPeak - 1) / samplesPerPeak));
+    }
+}
+
+void WaveformPeaks::addSamples(const juce::AudioBuffer<float>& buffer, int numSamples)
+{
+    const int numChannels = buffer.getNumChannels();
+    if (numChannels == 0)
+        return;
+
+    for (int offset = 0; offset < numSamples;)
+    {
+        // never past the end of the current level-0 peak
+        const int span = juce::jmin(numSamples - offset,
+            baseSamplesPerPeak - (int)accumulators[0].numSamples);
+
+        float min = 0.0f, max = 0.0f;
+        double sumSquares = 0.0;
+
+        for (int chan = 0; chan < numChannels; ++chan)
+        {
+            const float* data = buffer.getReadPointer(chan, offset);
+            auto range = juce::FloatVectorOperations::findMinAndMax(data, span);
+            min = chan == 0 ? range.getStart() : juce::jmin(min, range.getStart());
+            max = chan == 0 ? range.getEnd() : juce::jmax(max, range.getEnd());
+
+            float squares = 0.0f;
+            for (int i = 0; i < span; ++i)
+                squares += data[i] * data[i];
+            sumSquares += squares;
+        }
+
+        addToLevel(0, min, max, sumSquares / numChannels, span);
+        offset += span;
+    }
+}
+
+void WaveformPeaks::addToLevel(int level, float min, float max, double sumSquares, juce::int64 numSamples)
+{
+    auto& acc = accumulators[(size_t)level];
+    acc.min = acc.numSamples == 0 ? min : juce::jmin(acc.min, min);
+    acc.max = acc.numSamples == 0 ? max : juce::jmax(acc.max, max);
+    acc.sumSquares += sumSquares;
+    acc.numSamples += numSamples;
+    ++acc.numInputs;
+
+    if (level == 0 ? acc.numSamples >= baseSamplesPerPeak : acc.numInputs >= levelRatio)
+        emit(level);
+}
+
+void WaveformPeaks::emit(int level)
+{
+    auto acc = accumulators[(size_t)level];
+    accumulators[(size_t)level] = {};
+
+    if (acc.numSamples == 0)
+        return;
+
+    // a reader may deliver more than it announced; the extra is simply not drawn
+    auto& peaks = levels[(size_t)level];
+    const int index = ready[(size_t)level].load(std::memory_order_relaxed);
+    if (index < (int)peaks.size())
+    {
+        peaks[(size_t)index] = { quantiseSigned(acc.min), quantiseSigned(acc.max),
+            quantiseUnsigned(std::sqrt(acc.sumSquares / (double)acc.numSamples)) };
+        ready[(size_t)level].store(index + 1, std::memory_order_release);
+    }
+
+    if (level + 1 < numLevels)
+        addToLevel(level + 1, acc.min, acc.max, acc.sumSquares, acc.numSamples);
+}
+
+void WaveformPeaks::finish()
+{
+    // partial peaks at the end of the track; each flush feeds the level above before it is flushed
+    for (int level = 0; level < numLevels; ++level)
+        emit(level);
+
+    complete.store(true, std::memory_order_release);
+}
+
+void WaveformPeaks::writeTo(juce::OutputStream& stream) const
+{
+    stream.writeInt(peaksMagic);
+    stream.writeInt(formatVersion);
+    stream.writeInt64(lengthInSamples);
+    stream.writeDouble(sampleRate);
+    stream.writeInt(numLevels);
+    stream.writeInt(baseSamplesPerPeak);
+    stream.writeInt(levelRatio);
+
+    for (int level = 0; level < numLevels; ++level)
+    {
+        const int count = getNumReady(level);
+        juce::MemoryBlock bytes((size_t)count * 3);
+        auto* out = static_cast<juce::uint8*>(bytes.getData());
+
+        for (int i = 0; i < count; ++i)
+        {
+            const auto& peak = levels[(size_t)level][(size_t)i];
+            *out++ = (juce::uint8)peak.min;
+            *out++ = (juce::uint8)peak.max;
+            *out++ = peak.rms;
+        }
+
+        stream.writeInt(count);
+        stream.write(bytes.getData(), bytes.getSize());
+    }
+}
+
+std::unique_ptr<WaveformPeaks> WaveformPeaks::readFrom(juce::InputStream& stream)
+{
+    if (stream.readInt() != peaksMagic || stream.readInt() != formatVersion)
+        return nullptr;
+
+    const auto length = stream.readInt64();
+    const double rate = stream.readDouble();
+    if (length < 0 || rate <= 0.0 || stream.readInt() != numLevels
+        || stream.readInt() != baseSamplesPerPeak || stream.readInt() != levelRatio)
+        return nullptr;
+
+    auto result = std::make_unique<WaveformPeaks>(length, rate);
+
+    for (int level = 0; level < numLevels; ++level)
+    {
+        const int count = stream.readInt();
+        if (count < 0 || count > result->getNumPeaks(level))
+            return nullptr;
+
+        juce::MemoryBlock bytes;
+        if (stream.readIntoMemoryBlock(bytes, count * 3) != (size_t)count * 3)
+            return nullptr;
+
+        auto* in = static_cast<const juce::uint8*>(bytes.getData());
+        for (int i = 0; i < count; ++i, in += 3)
+            result->levels[(size_t)level][(size_t)i] = { (juce::int8)in[0], (juce::int8)in[1], in[2] };
+
+        result->ready[(size_t)level].store(count);
+    }
+
+    result->complete = true;
+    return result;
+}
+
+//==============================================================================
+WaveformGenerator::WaveformGenerator()
+    : juce::Thread("Waveform analysis")
+{
+    formatManager.registerBasicFormats();
+    startThread(juce::Thread::Priority::low);
+}
+
+WaveformGenerator::~WaveformGenerator()
+{
+    ++generation;
+    stopThread(4000);
+}
+
+juce::File WaveformGenerator::getCacheDirectory()
+{
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+        .getChildFile("AudioPlayer").getChildFile("WaveformCache");
+}
+
+juce::File WaveformGenerator::getCacheFile(const juce::File& audioFile)
+{
+    // one entry per path; the size and modification time inside decide whether it is still valid
+    return getCacheDirectory().getChildFile(juce::String::toHexString(audioFile.getFullPathName().hashCode64()) + ".peaks");
+}
+
+void WaveformGenerator::setFile(const juce::File& file)
+{
+    requestedFile = file;
+
+    {
+        const juce::ScopedLock sl(lock);
+        pendingFile = file;
+        hasRequest = file != juce::File();
+        peaks.reset();
+        ++generation;
+    }
+
+    notify();
+}
+
+std::shared_ptr<const WaveformPeaks> WaveformGenerator::getPeaks() const
+{
+    const juce::ScopedLock sl(lock);
+    return peaks;
+}
+
+void WaveformGenerator::run()
+{
+    while (!threadShouldExit())
+    {
+        juce::File file;
+        juce::uint32 requestGeneration = 0;
+
+        {
+            const juce::ScopedLock sl(lock);
+            if (hasRequest)
+            {
+                file = pendingFile;
+                requestGeneration = generation.load();
+                hasRequest = false;
+            }
+        }
+
+        if (file == juce::File())
+        {
+            wait(-1);
+            continue;
+        }
+
+        analyse(file, requestGeneration);
+    }
+}
+
+void WaveformGenerator::analyse(const juce::File& file, juce::uint32 requestGeneration)
+{
+    auto publish = [this, requestGeneration](std::shared_ptr<WaveformPeaks> newPeaks)
+        {
+            const juce::ScopedLock sl(lock);
+            if (generation.load() != requestGeneration)
+                return false;
+
+            peaks = std::move(newPeaks);
+            return true;
+        };
+
+    const auto fileSize = file.getSize();
+    const auto modified = file.getLastModificationTime().toMilliseconds();
+    const auto cacheFile = getCacheFile(file);
+
+    if (auto in = cacheFile.createInputStream())
+    {
+        if (in->readInt() == cacheMagic && in->readString() == file.getFullPathName()
+            && in->readInt64() == fileSize && in->readInt64() == modified)
+        {
+            if (auto cached = WaveformPeaks::readFrom(*in))
+            {
+                publish(std::move(cached));
+                return;
+            }
+        }
+    }
+
+    std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(file));
+    if (reader == nullptr || reader->sampleRate <= 0.0)
+        return;
+
+    auto newPeaks = std::make_shared<WaveformPeaks>(reader->lengthInSamples, reader->sampleRate);
+    if (!publish(newPeaks))
+        return;
+
+    juce::AudioBuffer<float> buffer((int)juce::jmax(1u, reader->numChannels), analysisBlockSize);
+
+    for (juce::int64 position = 0; position < reader->lengthInSamples; position += analysisBlockSize)
+    {
+        // superseded by another track, or shutting down
+        if (threadShouldExit() || generation.load() != requestGeneration)
+            return;
+
+        const int numSamples = (int)juce::jmin((juce::int64)analysisBlockSize, reader->lengthInSamples - position);
+        if (!reader->read(&buffer, 0, numSamples, position, true, true))
+        {
+            // show what was read, but never cache a waveform the next load would trust as whole
+            newPeaks->finish();
+            return;
+        }
+
+        newPeaks->addSamples(buffer, numSamples);
+    }
+
+    newPeaks->finish();
+
+    juce::MemoryOutputStream out;
+    out.writeInt(cacheMagic);
+    out.writeString(file.getFullPathName());
+    out.writeInt64(fileSize);
+    out.writeInt64(modified);
+    newPeaks->writeTo(out);
+
+    // a cache entry that cannot be written is simply analysed again next time
+    writeFileAtomically(cacheFile, out.getMemoryBlock());
+}
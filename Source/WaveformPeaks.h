@@ -0,0 +1,104 @@
+/*
+  ==============================================================================
+
+    WaveformPeaks.h
+    Created: 18 Oct 2026 4:52:40am
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// A min/max/RMS overview of a track at several zoom levels. Level 0 holds one
+// peak per baseSamplesPerPeak samples, each further level one per levelRatio
+// peaks of the level below. Analysis fills every level from the start of the
+// track; peaks below getNumReady() are final and safe to read on any thread.
+class WaveformPeaks
+{
+public:
+    static constexpr int baseSamplesPerPeak = 256;
+    static constexpr int levelRatio = 4;
+    static constexpr int numLevels = 5;  // 256 to 65536 samples per peak
+
+    // quantised to a byte each: min and max as -127..127, rms as 0..255
+    struct Peak
+    {
+        juce::int8 min = 0, max = 0;
+        juce::uint8 rms = 0;
+    };
+
+    WaveformPeaks(juce::int64 lengthInSamples, double sampleRate);
+
+    juce::int64 getLengthInSamples() const { return lengthInSamples; }
+    double getSampleRate() const { return sampleRate; }
+    static int getSamplesPerPeak(int level) { return baseSamplesPerPeak << (2 * level); }
+    int getNumPeaks(int level) const { return (int)levels[(size_t)level].size(); }
+    int getNumReady(int level) const { return ready[(size_t)level].load(std::memory_order_acquire); }
+    const Peak* getPeaks(int level) const { return levels[(size_t)level].data(); }
+    bool isComplete() const { return complete.load(std::memory_order_acquire); }
+
+    // Analysis, from one thread only: the track's samples in order, then finish()
+    void addSamples(const juce::AudioBuffer<float>& buffer, int numSamples);
+    void finish();
+
+    // Compact binary form, as kept in the cache; readFrom returns nullptr for anything malformed
+    void writeTo(juce::OutputStream& stream) const;
+    static std::unique_ptr<WaveformPeaks> readFrom(juce::InputStream& stream);
+
+private:
+    struct Accumulator
+    {
+        float min = 0.0f, max = 0.0f;
+        double sumSquares = 0.0;
+        juce::int64 numSamples = 0;
+        int numInputs = 0;
+    };
+
+    void addToLevel(int level, float min, float max, double sumSquares, juce::int64 numSamples);
+    void emit(int level);
+
+    juce::int64 lengthInSamples;
+    double sampleRate;
+    std::array<std::vector<Peak>, numLevels> levels;
+    std::array<std::atomic<int>, numLevels> ready{};
+    std::array<Accumulator, numLevels> accumulators{};
+    std::atomic<bool> complete{ false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(WaveformPeaks)
+};
+
+// Builds the peaks of one track at a time on a low-priority worker, so a deck can
+// start playing before its overview is done. Finished peaks are cached on disk,
+// keyed by the file's path, size and modification time, and a reload reads them
+// back instead of decoding the track again.
+class WaveformGenerator : private juce::Thread
+{
+public:
+    WaveformGenerator();
+    ~WaveformGenerator() override;
+
+    // Message thread; drops whatever was being analysed
+    void setFile(const juce::File& file);
+    const juce::File& getFile() const { return requestedFile; }
+
+    // Any thread; nullptr until the track is opened, then filling in as analysis runs
+    std::shared_ptr<const WaveformPeaks> getPeaks() const;
+
+    static juce::File getCacheDirectory();
+    static juce::File getCacheFile(const juce::File& audioFile);
+
+private:
+    void run() override;
+    void analyse(const juce::File& file, juce::uint32 requestGeneration);
+
+    juce::AudioFormatManager formatManager;
+    juce::File requestedFile;
+    mutable juce::CriticalSection lock;
+    juce::File pendingFile;
+    bool hasRequest = false;
+    std::shared_ptr<WaveformPeaks> peaks;
+    std::atomic<juce::uint32> generation{ 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(WaveformGenerator)
+};